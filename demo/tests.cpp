@@ -5,6 +5,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <algorithm>
 #include <vector>
 
 // This file uses assert() to verify algorithm correctness
@@ -77,6 +78,112 @@ static const unsigned char kVertexDataV1Custom[] = {
     0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x62 //
 };
 
+static void dispatchReverse(void*, void (*task)(void*, size_t), void* task_context, size_t task_count)
+{
+	// tasks must be independent, so running them in reverse order should produce the same result
+	for (size_t i = task_count; i > 0; --i)
+		task(task_context, i - 1);
+}
+
+// Appends two triangles for each cell of an NxN grid of vertices with (N+1) vertices per row
+static void makeGridIndices(std::vector<unsigned int>& ib, size_t N)
+{
+	for (size_t y = 0; y < N; ++y)
+		for (size_t x = 0; x < N; ++x)
+		{
+			unsigned int v0 = unsigned(y * (N + 1) + x), v1 = v0 + 1, v2 = v0 + unsigned(N + 1), v3 = v2 + 1;
+			unsigned int quad[] = {v0, v1, v2, v2, v1, v3};
+
+			ib.insert(ib.end(), quad, quad + 6);
+		}
+}
+
+// Generates an NxN grid of cells with float3 positions; height is sin(x*fx)*cos(y*fy)*scale
+static void makeGrid(std::vector<float>& vb, std::vector<unsigned int>& ib, size_t N, float fx, float fy, float scale)
+{
+	for (size_t y = 0; y <= N; ++y)
+		for (size_t x = 0; x <= N; ++x)
+		{
+			vb.push_back(float(x));
+			vb.push_back(float(y));
+			vb.push_back(sinf(float(x) * fx) * cosf(float(y) * fy) * scale);
+		}
+
+	makeGridIndices(ib, N);
+}
+
+// Generates an NxN grid of cells with a UV seam along x=N/2; vertices have float3 position and float2 UV, and height is sin(x*fx)*cos(y*fy)
+static void makeSeamGrid(std::vector<float>& vb, std::vector<unsigned int>& ib, size_t N, float fx, float fy)
+{
+	for (size_t y = 0; y <= N; ++y)
+		for (size_t x = 0; x <= N + 1; ++x)
+		{
+			float px = float(x <= N / 2 ? x : x - 1);
+
+			vb.push_back(px);
+			vb.push_back(float(y));
+			vb.push_back(sinf(px * fx) * cosf(float(y) * fy));
+			vb.push_back(x <= N / 2 ? px / float(N) : 1.f - px / float(N));
+			vb.push_back(float(y) / float(N));
+		}
+
+	// vertices at x=N/2 are duplicated, so each row has N+2 vertices and cells to the right of the seam use the second copy
+	for (size_t y = 0; y < N; ++y)
+		for (size_t x = 0; x < N; ++x)
+		{
+			unsigned int v0 = unsigned(y * (N + 2) + x + (x >= N / 2)), v1 = v0 + 1, v2 = v0 + unsigned(N + 2), v3 = v2 + 1;
+			unsigned int quad[] = {v0, v1, v2, v2, v1, v3};
+
+			ib.insert(ib.end(), quad, quad + 6);
+		}
+}
+
+// Appends edges without a matching opposite edge, using remap to treat vertices with the same position as one vertex
+static void getOpenEdges(std::vector<unsigned long long>& result, const unsigned int* indices, size_t index_count, const unsigned int* remap)
+{
+	std::vector<unsigned long long> edges;
+
+	for (size_t i = 0; i < index_count; i += 3)
+		for (int e = 0; e < 3; ++e)
+		{
+			unsigned int a = remap[indices[i + e]], b = remap[indices[i + (e + 1) % 3]];
+			edges.push_back((unsigned long long)a << 32 | b);
+		}
+
+	std::sort(edges.begin(), edges.end());
+
+	for (size_t i = 0; i < edges.size(); ++i)
+	{
+		unsigned long long reverse = (edges[i] << 32) | (edges[i] >> 32);
+
+		if (!std::binary_search(edges.begin(), edges.end(), reverse))
+			result.push_back(edges[i]);
+	}
+}
+
+// Counts open edges of the mesh that are not between border positions of the source mesh, e.g. cracks along seams or tile boundaries
+static size_t countOpenInteriorEdges(const unsigned int* indices, size_t index_count, const unsigned int* source, size_t source_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride)
+{
+	std::vector<unsigned int> remap(vertex_count);
+	meshopt_generatePositionRemap(&remap[0], vertex_positions, vertex_count, vertex_positions_stride);
+
+	std::vector<unsigned long long> edges;
+	getOpenEdges(edges, source, source_count, &remap[0]);
+
+	std::vector<unsigned char> border(vertex_count);
+	for (size_t i = 0; i < edges.size(); ++i)
+		border[edges[i] >> 32] = border[edges[i] & 0xffffffff] = 1;
+
+	edges.clear();
+	getOpenEdges(edges, indices, index_count, &remap[0]);
+
+	size_t result = 0;
+	for (size_t i = 0; i < edges.size(); ++i)
+		result += !border[edges[i] >> 32] || !border[edges[i] & 0xffffffff];
+
+	return result;
+}
+
 static void decodeIndexV0()
 {
 	const size_t index_count = sizeof(kIndexBuffer) / sizeof(kIndexBuffer[0]);
@@ -274,6 +381,59 @@ static void encodeIndexEmpty()
 	assert(meshopt_decodeIndexBuffer(static_cast<unsigned int*>(NULL), 0, &buffer[0], buffer.size()) == 0);
 }
 
+static void decodeIndexParallel()
+{
+	const size_t N = 40;
+
+	std::vector<unsigned int> indices;
+
+	makeGridIndices(indices, N);
+
+	// restarts and strip-like sequences exercise all encoder paths
+	for (int k = 0; k < 10; ++k)
+		indices.insert(indices.end(), kIndexBufferTricky, kIndexBufferTricky + sizeof(kIndexBufferTricky) / sizeof(kIndexBufferTricky[0]));
+
+	meshopt_optimizeVertexCache(&indices[0], &indices[0], indices.size(), (N + 1) * (N + 1));
+
+	for (int version = 0; version <= 1; ++version)
+	{
+		meshopt_encodeIndexVersion(version);
+
+		std::vector<unsigned char> expected(meshopt_encodeIndexBufferBound(indices.size(), (N + 1) * (N + 1)));
+		expected.resize(meshopt_encodeIndexBuffer(&expected[0], expected.size(), &indices[0], indices.size()));
+
+		std::vector<unsigned char> buffer(meshopt_encodeIndexBufferBound(indices.size(), (N + 1) * (N + 1)));
+		std::vector<unsigned char> seek(meshopt_encodeIndexSeekSize(indices.size(), 101));
+		buffer.resize(meshopt_encodeIndexBufferSeekable(&buffer[0], buffer.size(), &seek[0], seek.size(), &indices[0], indices.size(), 101));
+
+		// seekable encoding should not change the encoded data
+		assert(buffer == expected);
+
+		// note: the encoder may rotate triangles, so we compare against the serial decoder output
+		std::vector<unsigned int> reference(indices.size());
+		assert(meshopt_decodeIndexBuffer(&reference[0], indices.size(), &buffer[0], buffer.size()) == 0);
+
+		std::vector<unsigned int> decoded(indices.size());
+		assert(meshopt_decodeIndexBufferParallel(&decoded[0], indices.size(), 4, &buffer[0], buffer.size(), &seek[0], seek.size(), dispatchReverse, NULL) == 0);
+		assert(decoded == reference);
+
+		std::vector<unsigned short> decoded16(indices.size());
+		assert(meshopt_decodeIndexBufferParallel(&decoded16[0], indices.size(), 2, &buffer[0], buffer.size(), &seek[0], seek.size(), NULL, NULL) == 0);
+		for (size_t i = 0; i < indices.size(); ++i)
+			assert(decoded16[i] == reference[i]);
+
+		// truncated seek tables and inconsistent offsets are rejected
+		assert(meshopt_decodeIndexBufferParallel(&decoded[0], indices.size(), 4, &buffer[0], buffer.size(), &seek[0], seek.size() - 1, NULL, NULL) < 0);
+
+		std::vector<unsigned char> corrupt = seek;
+		corrupt[seek.size() / 2] ^= 1;
+		corrupt[4 + 208 * 3] ^= 1;
+		assert(meshopt_decodeIndexBufferParallel(&decoded[0], indices.size(), 4, &buffer[0], buffer.size(), &corrupt[0], corrupt.size(), NULL, NULL) < 0);
+	}
+
+	meshopt_encodeIndexVersion(1);
+}
+
 static void decodeIndexSequence()
 {
 	const size_t index_count = sizeof(kIndexSequence) / sizeof(kIndexSequence[0]);
@@ -732,6 +892,309 @@ static void decodeVertexSmall()
 	assert(memcmp(decoded, data, sizeof(data)) == 0);
 }
 
+static void decodeVertexSimdLevel()
+{
+	const size_t vertex_count = 1000;
+	unsigned int data[vertex_count * 4];
+
+	// this tests all bit group widths and delta types across multiple blocks
+	for (size_t i = 0; i < vertex_count; ++i)
+	{
+		unsigned int h = unsigned(i) * 0x9e3779b9u;
+
+		data[i * 4 + 0] = unsigned(i);
+		data[i * 4 + 1] = (unsigned(i) * 3) << 12;
+		data[i * 4 + 2] = h >> (i % 32);
+		data[i * 4 + 3] = (i % 7 == 0) ? h : 0;
+	}
+
+	std::vector<unsigned char> buffer(meshopt_encodeVertexBufferBound(vertex_count, 16));
+	buffer.resize(meshopt_encodeVertexBufferLevel(&buffer[0], buffer.size(), data, vertex_count, 16, 3, -1));
+
+	for (int level = 0; level <= 2; ++level)
+	{
+		int actual = meshopt_decodeVertexSimdLevel(level);
+		assert(actual >= 0 && actual <= 2);
+
+		unsigned int decoded[vertex_count * 4];
+		assert(meshopt_decodeVertexBuffer(decoded, vertex_count, 16, &buffer[0], buffer.size()) == 0);
+		assert(memcmp(decoded, data, sizeof(data)) == 0);
+	}
+
+	// restore default (highest supported) level
+	meshopt_decodeVertexSimdLevel(2);
+}
+
+static void encodeVertexParallel()
+{
+	const size_t vertex_count = 20000;
+	std::vector<unsigned int> data(vertex_count * 4);
+
+	for (size_t i = 0; i < vertex_count; ++i)
+	{
+		unsigned int h = unsigned(i) * 0x9e3779b9u;
+
+		data[i * 4 + 0] = unsigned(i / 7);
+		data[i * 4 + 1] = (unsigned(i) * 3) << 12;
+		data[i * 4 + 2] = h >> (i % 32);
+		data[i * 4 + 3] = (i % 5 == 0) ? h : 0;
+	}
+
+	// 8-byte vertices exercise a different block size and fewer channels
+	size_t sizes[] = {16, 8};
+
+	for (size_t si = 0; si < sizeof(sizes) / sizeof(sizes[0]); ++si)
+	{
+		size_t vertex_size = sizes[si];
+		size_t count = data.size() * 4 / vertex_size;
+
+		std::vector<unsigned char> expected(meshopt_encodeVertexBufferBound(count, vertex_size));
+		std::vector<unsigned char> actual(expected.size());
+
+		for (int level = 0; level <= 3; ++level)
+		{
+			size_t expected_size = meshopt_encodeVertexBufferLevel(&expected[0], expected.size(), &data[0], count, vertex_size, level, -1);
+			assert(expected_size > 0);
+
+			size_t actual_size = meshopt_encodeVertexBufferParallel(&actual[0], actual.size(), &data[0], count, vertex_size, level, -1, dispatchReverse, NULL);
+			assert(actual_size == expected_size);
+			assert(memcmp(&actual[0], &expected[0], expected_size) == 0);
+
+			// serial dispatch and exact or insufficient buffer sizes should match the serial encoder as well
+			assert(meshopt_encodeVertexBufferParallel(&actual[0], expected_size, &data[0], count, vertex_size, level, -1, NULL, NULL) == expected_size);
+			assert(memcmp(&actual[0], &expected[0], expected_size) == 0);
+			assert(meshopt_encodeVertexBufferParallel(&actual[0], expected_size - 1, &data[0], count, vertex_size, level, -1, NULL, NULL) == 0);
+		}
+	}
+
+	// empty and single vertex buffers have no tasks to run
+	unsigned char buffer[128];
+	for (size_t count = 0; count <= 1; ++count)
+	{
+		size_t expected_size = meshopt_encodeVertexBufferLevel(buffer, sizeof(buffer), &data[0], count, 16, 3, -1);
+		assert(meshopt_encodeVertexBufferParallel(buffer + 64, sizeof(buffer) - 64, &data[0], count, 16, 3, -1, dispatchReverse, NULL) == expected_size);
+		assert(memcmp(buffer, buffer + 64, expected_size) == 0);
+	}
+}
+
+static void decodeVertexRange()
+{
+	const size_t vertex_count = 2000;
+	std::vector<unsigned int> data(vertex_count * 4);
+
+	for (size_t i = 0; i < vertex_count; ++i)
+	{
+		data[i * 4 + 0] = unsigned(i);
+		data[i * 4 + 1] = unsigned(i * i);
+		data[i * 4 + 2] = unsigned(i) * 0x9e3779b9u;
+		data[i * 4 + 3] = 42;
+	}
+
+	std::vector<unsigned char> buffer(meshopt_encodeVertexBufferBound(vertex_count, 16));
+	std::vector<unsigned char> seek(meshopt_encodeVertexSeekSize(vertex_count, 16));
+
+	buffer.resize(meshopt_encodeVertexBufferSeekable(&buffer[0], buffer.size(), &seek[0], seek.size(), &data[0], vertex_count, 16, 2, -1));
+	assert(buffer.size() > 0);
+
+	// seekable encoding should not change the encoded data
+	std::vector<unsigned char> expected(meshopt_encodeVertexBufferBound(vertex_count, 16));
+	expected.resize(meshopt_encodeVertexBufferLevel(&expected[0], expected.size(), &data[0], vertex_count, 16, 2, -1));
+	assert(buffer == expected);
+
+	// ranges that start/end inside blocks, on block boundaries, cover the last block or are empty
+	size_t ranges[][2] = {{0, vertex_count}, {0, 1}, {100, 300}, {256, 512}, {511, 1025}, {1900, vertex_count}, {vertex_count - 1, vertex_count}, {700, 700}};
+
+	for (size_t i = 0; i < sizeof(ranges) / sizeof(ranges[0]); ++i)
+	{
+		size_t first = ranges[i][0], last = ranges[i][1];
+
+		std::vector<unsigned int> decoded((last - first) * 4 + 1, 0xcdcdcdcd);
+		assert(meshopt_decodeVertexBufferRange(&decoded[0], first, last, vertex_count, 16, &buffer[0], buffer.size(), &seek[0], seek.size()) == 0);
+		assert(memcmp(&decoded[0], &data[first * 4], (last - first) * 16) == 0);
+		assert(decoded[(last - first) * 4] == 0xcdcdcdcd);
+	}
+
+	// truncated seek tables and corrupted offsets are rejected
+	unsigned int decoded[4];
+	assert(meshopt_decodeVertexBufferRange(decoded, 1999, 2000, vertex_count, 16, &buffer[0], buffer.size(), &seek[0], seek.size() - 1) < 0);
+
+	seek[20 * 3 + 3] = 0xff;
+	assert(meshopt_decodeVertexBufferRange(decoded, 999, 1000, vertex_count, 16, &buffer[0], buffer.size(), &seek[0], seek.size()) < 0);
+}
+
+static void decodeVertexFiltered()
+{
+	const size_t vertex_count = 1000;
+
+	// data spans multiple blocks and a partial tail block
+	std::vector<float> data(vertex_count * 4);
+	for (size_t i = 0; i < vertex_count; ++i)
+	{
+		float a = float(i) * 0.01f;
+
+		data[i * 4 + 0] = cosf(a) * 0.6f;
+		data[i * 4 + 1] = sinf(a) * 0.6f;
+		data[i * 4 + 2] = 0.64f;
+		data[i * 4 + 3] = float(i % 7) / 7.f;
+	}
+
+	const meshopt_DecodeFilter filters[] = {meshopt_DecodeFilterNone, meshopt_DecodeFilterOct, meshopt_DecodeFilterQuat, meshopt_DecodeFilterExp, meshopt_DecodeFilterColor};
+
+	for (size_t k = 0; k < sizeof(filters) / sizeof(filters[0]); ++k)
+	{
+		meshopt_DecodeFilter filter = filters[k];
+		size_t vertex_size = (filter == meshopt_DecodeFilterExp) ? 16 : 8;
+
+		std::vector<unsigned char> filtered(vertex_count * vertex_size);
+
+		if (filter == meshopt_DecodeFilterOct)
+			meshopt_encodeFilterOct(&filtered[0], vertex_count, vertex_size, 12, &data[0]);
+		else if (filter == meshopt_DecodeFilterQuat)
+			meshopt_encodeFilterQuat(&filtered[0], vertex_count, vertex_size, 12, &data[0]);
+		else if (filter == meshopt_DecodeFilterExp)
+			meshopt_encodeFilterExp(&filtered[0], vertex_count, vertex_size, 15, &data[0], meshopt_EncodeExpSeparate);
+		else if (filter == meshopt_DecodeFilterColor)
+			meshopt_encodeFilterColor(&filtered[0], vertex_count, vertex_size, 12, &data[0]);
+		else
+			memcpy(&filtered[0], &data[0], filtered.size());
+
+		std::vector<unsigned char> buffer(meshopt_encodeVertexBufferBound(vertex_count, vertex_size));
+		buffer.resize(meshopt_encodeVertexBuffer(&buffer[0], buffer.size(), &filtered[0], vertex_count, vertex_size));
+
+		// fused decoding must match decoding followed by a separate filter pass
+		std::vector<unsigned char> expected(vertex_count * vertex_size);
+		assert(meshopt_decodeVertexBuffer(&expected[0], vertex_count, vertex_size, &buffer[0], buffer.size()) == 0);
+
+		if (filter == meshopt_DecodeFilterOct)
+			meshopt_decodeFilterOct(&expected[0], vertex_count, vertex_size);
+		else if (filter == meshopt_DecodeFilterQuat)
+			meshopt_decodeFilterQuat(&expected[0], vertex_count, vertex_size);
+		else if (filter == meshopt_DecodeFilterExp)
+			meshopt_decodeFilterExp(&expected[0], vertex_count, vertex_size);
+		else if (filter == meshopt_DecodeFilterColor)
+			meshopt_decodeFilterColor(&expected[0], vertex_count, vertex_size);
+
+		std::vector<unsigned char> decoded(vertex_count * vertex_size);
+		assert(meshopt_decodeVertexBufferFiltered(&decoded[0], vertex_count, vertex_size, &buffer[0], buffer.size(), filter) == 0);
+		assert(decoded == expected);
+
+		// malformed input is rejected just like in the unfused decoder
+		assert(meshopt_decodeVertexBufferFiltered(&decoded[0], vertex_count, vertex_size, &buffer[0], buffer.size() - 1, filter) < 0);
+	}
+}
+
+static void decodeVertexRef()
+{
+	const size_t vertex_count = 1000;
+
+	std::vector<unsigned int> base(vertex_count * 4), target(vertex_count * 4);
+
+	// target deviates from the base in a contiguous region, like a morph target would
+	for (size_t i = 0; i < vertex_count; ++i)
+	{
+		unsigned int h = unsigned(i) * 0x9e3779b9u;
+
+		base[i * 4 + 0] = h;
+		base[i * 4 + 1] = unsigned(i) << 8;
+		base[i * 4 + 2] = h >> 16;
+		base[i * 4 + 3] = 0x3f800000;
+
+		target[i * 4 + 0] = base[i * 4 + 0];
+		target[i * 4 + 1] = base[i * 4 + 1] + (i > 300 && i < 600 ? unsigned(i % 16) : 0);
+		target[i * 4 + 2] = base[i * 4 + 2] - (i > 400 && i < 500 ? 3 : 0);
+		target[i * 4 + 3] = base[i * 4 + 3];
+	}
+
+	std::vector<unsigned char> plain(meshopt_encodeVertexBufferBound(vertex_count, 16));
+	plain.resize(meshopt_encodeVertexBuffer(&plain[0], plain.size(), &target[0], vertex_count, 16));
+
+	std::vector<unsigned char> buffer(meshopt_encodeVertexBufferBound(vertex_count, 16));
+	buffer.resize(meshopt_encodeVertexBufferRef(&buffer[0], buffer.size(), &target[0], vertex_count, 16, &base[0], 2, -1));
+	assert(buffer.size() > 0 && buffer.size() * 4 < plain.size());
+
+	std::vector<unsigned int> decoded(vertex_count * 4);
+	assert(meshopt_decodeVertexBufferRef(&decoded[0], vertex_count, 16, &buffer[0], buffer.size(), &base[0]) == 0);
+	assert(decoded == target);
+
+	// encoding relative to itself produces a buffer of zeroes
+	buffer.resize(meshopt_encodeVertexBufferBound(vertex_count, 16));
+	buffer.resize(meshopt_encodeVertexBufferRef(&buffer[0], buffer.size(), &base[0], vertex_count, 16, &base[0], 2, -1));
+
+	assert(meshopt_decodeVertexBuffer(&decoded[0], vertex_count, 16, &buffer[0], buffer.size()) == 0);
+	for (size_t i = 0; i < decoded.size(); ++i)
+		assert(decoded[i] == 0);
+
+	assert(meshopt_decodeVertexBufferRef(&decoded[0], vertex_count, 16, &buffer[0], buffer.size() - 1, &base[0]) < 0);
+}
+
+static void appendStreamOutput(void* context, const unsigned char* data, size_t size)
+{
+	std::vector<unsigned char>* output = static_cast<std::vector<unsigned char>*>(context);
+	output->insert(output->end(), data, data + size);
+}
+
+static void encodeVertexStream()
+{
+	const size_t vertex_count = 1000;
+
+	std::vector<unsigned int> data(vertex_count * 4);
+	for (size_t i = 0; i < vertex_count; ++i)
+	{
+		unsigned int h = unsigned(i) * 0x9e3779b9u;
+
+		data[i * 4 + 0] = unsigned(i);
+		data[i * 4 + 1] = h >> (i % 32);
+		data[i * 4 + 2] = (unsigned(i) * 3) << 12;
+		data[i * 4 + 3] = 0x3f800000 | (h >> 20);
+	}
+
+	// chunk sizes straddle block boundaries in different ways; 0 vertices is a valid (no-op) chunk
+	const size_t chunks[] = {1, 0, 7, 300, 64, 1000};
+
+	for (int level = 0; level <= 3; ++level)
+	{
+		std::vector<unsigned char> output;
+
+		meshopt_VertexStreamEncoder encoder;
+		meshopt_encodeVertexStreamBegin(&encoder, 16, level, -1, appendStreamOutput, &output);
+
+		for (size_t offset = 0, i = 0; offset < vertex_count; ++i)
+		{
+			size_t count = std::min(chunks[i % (sizeof(chunks) / sizeof(chunks[0]))], vertex_count - offset);
+			meshopt_encodeVertexStreamAppend(&encoder, &data[offset * 4], count);
+			offset += count;
+		}
+
+		size_t size = meshopt_encodeVertexStreamEnd(&encoder);
+		assert(size == output.size());
+		assert(encoder.vertex_count == vertex_count);
+
+		std::vector<unsigned int> decoded(vertex_count * 4);
+		assert(meshopt_decodeVertexBuffer(&decoded[0], vertex_count, 16, &output[0], output.size()) == 0);
+		assert(decoded == data);
+
+		// without channel estimation, the output matches the regular encoder
+		if (level <= 1)
+		{
+			std::vector<unsigned char> buffer(meshopt_encodeVertexBufferBound(vertex_count, 16));
+			buffer.resize(meshopt_encodeVertexBufferLevel(&buffer[0], buffer.size(), &data[0], vertex_count, 16, level, -1));
+
+			assert(buffer == output);
+		}
+	}
+
+	// empty stream matches the regular encoder as well
+	std::vector<unsigned char> output;
+
+	meshopt_VertexStreamEncoder encoder;
+	meshopt_encodeVertexStreamBegin(&encoder, 16, 2, -1, appendStreamOutput, &output);
+	assert(meshopt_encodeVertexStreamEnd(&encoder) == output.size());
+
+	unsigned char buffer[256];
+	assert(meshopt_encodeVertexBuffer(buffer, sizeof(buffer), NULL, 0, 16) == output.size());
+	assert(memcmp(buffer, &output[0], output.size()) == 0);
+}
+
 static void encodeVertexEmpty()
 {
 	std::vector<unsigned char> buffer(meshopt_encodeVertexBufferBound(0, 16));
@@ -1572,21 +2035,358 @@ static void meshletsSpatialDeep()
 
 	vb[0] = vb[1] = vb[2] = 0;
 
-	for (size_t i = 0; i < N; ++i)
+	for (size_t i = 0; i < N; ++i)
+	{
+		vb[(i + 1) * 3 + 0] = vb[(i + 1) * 3 + 1] = vb[(i + 1) * 3 + 2] = powf(1.2f, float(i));
+
+		ib[i * 3 + 0] = 0;
+		ib[i * 3 + 1] = ib[i * 3 + 2] = unsigned(i + 1);
+	}
+
+	size_t max_meshlets = meshopt_buildMeshletsBound(N * 3, max_vertices, max_triangles);
+	std::vector<meshopt_Meshlet> meshlets(max_meshlets);
+	std::vector<unsigned int> meshlet_vertices(N * 3);
+	std::vector<unsigned char> meshlet_triangles(N * 3);
+
+	size_t result = meshopt_buildMeshletsSpatial(&meshlets[0], &meshlet_vertices[0], &meshlet_triangles[0], &ib[0], N * 3, &vb[0], N + 1, sizeof(float) * 3, max_vertices, max_triangles, max_triangles, 0.f);
+	assert(result == N);
+}
+
+static void meshletsParallel()
+{
+	// large enough to be split into several chunks
+	const size_t N = 200;
+
+	std::vector<float> vb;
+	std::vector<unsigned int> ib;
+
+	makeGrid(vb, ib, N, 0.1f, 0.1f, 10.f);
+
+	const size_t max_vertices = 64, min_triangles = 32, max_triangles = 96;
+
+	size_t max_meshlets = meshopt_buildMeshletsBound(ib.size(), max_vertices, min_triangles) + ib.size() / 49152 + 1;
+
+	std::vector<meshopt_Meshlet> expected(max_meshlets);
+	std::vector<unsigned int> expected_vertices(ib.size());
+	std::vector<unsigned char> expected_triangles(ib.size());
+
+	expected.resize(meshopt_buildMeshletsParallel(&expected[0], &expected_vertices[0], &expected_triangles[0], &ib[0], ib.size(), &vb[0], vb.size() / 3, sizeof(float) * 3, max_vertices, min_triangles, max_triangles, 0.25f, 2.f, NULL, NULL));
+	assert(expected.size() > 0);
+
+	// results don't depend on the dispatch order
+	std::vector<meshopt_Meshlet> actual(max_meshlets);
+	std::vector<unsigned int> actual_vertices(ib.size());
+	std::vector<unsigned char> actual_triangles(ib.size());
+
+	actual.resize(meshopt_buildMeshletsParallel(&actual[0], &actual_vertices[0], &actual_triangles[0], &ib[0], ib.size(), &vb[0], vb.size() / 3, sizeof(float) * 3, max_vertices, min_triangles, max_triangles, 0.25f, 2.f, dispatchReverse, NULL));
+
+	assert(actual.size() == expected.size());
+	assert(memcmp(&actual[0], &expected[0], actual.size() * sizeof(meshopt_Meshlet)) == 0);
+	assert(memcmp(&actual_vertices[0], &expected_vertices[0], actual_vertices.size() * sizeof(unsigned int)) == 0);
+	assert(memcmp(&actual_triangles[0], &expected_triangles[0], actual_triangles.size()) == 0);
+
+	// meshlets are packed contiguously and cover every source triangle exactly once
+	std::vector<unsigned int> covered(vb.size() / 3 * 2);
+	size_t vertex_offset = 0, triangle_offset = 0;
+
+	for (size_t i = 0; i < actual.size(); ++i)
+	{
+		const meshopt_Meshlet& m = actual[i];
+
+		assert(m.vertex_offset == vertex_offset && m.triangle_offset == triangle_offset);
+		assert(m.vertex_count <= max_vertices && m.triangle_count >= 1 && m.triangle_count <= max_triangles);
+
+		for (size_t j = 0; j < m.triangle_count; ++j)
+		{
+			unsigned int a = actual_vertices[m.vertex_offset + actual_triangles[m.triangle_offset + j * 3 + 0]];
+			unsigned int b = actual_vertices[m.vertex_offset + actual_triangles[m.triangle_offset + j * 3 + 1]];
+			unsigned int c = actual_vertices[m.vertex_offset + actual_triangles[m.triangle_offset + j * 3 + 2]];
+
+			// each grid vertex is the smallest vertex of at most two triangles, distinguished by the middle vertex
+			unsigned int lo = a < b ? (a < c ? a : c) : (b < c ? b : c);
+			unsigned int hi = a > b ? (a > c ? a : c) : (b > c ? b : c);
+			unsigned int mid = a + b + c - lo - hi;
+
+			covered[lo * 2 + (mid == lo + N)]++;
+		}
+
+		vertex_offset += m.vertex_count;
+		triangle_offset += m.triangle_count * 3;
+	}
+
+	for (size_t y = 0; y < N; ++y)
+		for (size_t x = 0; x < N; ++x)
+		{
+			size_t v0 = y * (N + 1) + x;
+			assert(covered[v0 * 2 + 0] == 1 && covered[(v0 + 1) * 2 + 1] == 1);
+		}
+
+	// small meshes fit into one chunk and match meshopt_buildMeshletsFlex
+	size_t small_count = 6 * 20 * 20;
+
+	std::vector<meshopt_Meshlet> flex(meshopt_buildMeshletsBound(small_count, max_vertices, min_triangles));
+	flex.resize(meshopt_buildMeshletsFlex(&flex[0], &expected_vertices[0], &expected_triangles[0], &ib[0], small_count, &vb[0], vb.size() / 3, sizeof(float) * 3, max_vertices, min_triangles, max_triangles, 0.25f, 2.f));
+
+	actual.resize(max_meshlets);
+	actual.resize(meshopt_buildMeshletsParallel(&actual[0], &actual_vertices[0], &actual_triangles[0], &ib[0], small_count, &vb[0], vb.size() / 3, sizeof(float) * 3, max_vertices, min_triangles, max_triangles, 0.25f, 2.f, dispatchReverse, NULL));
+
+	assert(actual.size() == flex.size());
+	assert(memcmp(&actual[0], &flex[0], flex.size() * sizeof(meshopt_Meshlet)) == 0);
+	assert(memcmp(&actual_vertices[0], &expected_vertices[0], small_count * sizeof(unsigned int)) == 0);
+}
+
+static void meshletsSpatialParallel()
+{
+	// large enough to be split into several subtrees
+	const size_t N = 150;
+
+	std::vector<float> vb;
+	std::vector<unsigned int> ib;
+
+	makeGrid(vb, ib, N, 0.1f, 0.1f, 10.f);
+
+	const size_t configs[][3] = {{64, 32, 96}, {128, 128, 128}};
+
+	for (size_t c = 0; c < sizeof(configs) / sizeof(configs[0]); ++c)
+	{
+		size_t max_vertices = configs[c][0], min_triangles = configs[c][1], max_triangles = configs[c][2];
+		size_t max_meshlets = meshopt_buildMeshletsBound(ib.size(), max_vertices, min_triangles);
+
+		std::vector<meshopt_Meshlet> expected(max_meshlets);
+		std::vector<unsigned int> expected_vertices(ib.size());
+		std::vector<unsigned char> expected_triangles(ib.size());
+
+		expected.resize(meshopt_buildMeshletsSpatial(&expected[0], &expected_vertices[0], &expected_triangles[0], &ib[0], ib.size(), &vb[0], vb.size() / 3, sizeof(float) * 3, max_vertices, min_triangles, max_triangles, 0.5f));
+		assert(expected.size() > 0);
+
+		// results match the serial builder regardless of the dispatch order
+		std::vector<meshopt_Meshlet> actual(max_meshlets);
+		std::vector<unsigned int> actual_vertices(ib.size());
+		std::vector<unsigned char> actual_triangles(ib.size());
+
+		actual.resize(meshopt_buildMeshletsSpatialParallel(&actual[0], &actual_vertices[0], &actual_triangles[0], &ib[0], ib.size(), &vb[0], vb.size() / 3, sizeof(float) * 3, max_vertices, min_triangles, max_triangles, 0.5f, dispatchReverse, NULL));
+
+		assert(actual.size() == expected.size());
+		assert(memcmp(&actual[0], &expected[0], actual.size() * sizeof(meshopt_Meshlet)) == 0);
+		assert(memcmp(&actual_vertices[0], &expected_vertices[0], actual_vertices.size() * sizeof(unsigned int)) == 0);
+		assert(memcmp(&actual_triangles[0], &expected_triangles[0], actual_triangles.size()) == 0);
+	}
+}
+
+struct MeshletStreamContext
+{
+	std::vector<meshopt_Meshlet> meshlets;
+	std::vector<unsigned int> vertices;
+	std::vector<unsigned char> triangles;
+};
+
+static void meshletStreamCallback(void* context, const meshopt_Meshlet* meshlet, const unsigned int* meshlet_vertices, const unsigned char* meshlet_triangles)
+{
+	MeshletStreamContext& ctx = *static_cast<MeshletStreamContext*>(context);
+
+	assert(meshlet->vertex_offset == 0 && meshlet->triangle_offset == 0);
+
+	meshopt_Meshlet m = *meshlet;
+	m.vertex_offset = unsigned(ctx.vertices.size());
+	m.triangle_offset = unsigned(ctx.triangles.size());
+
+	ctx.meshlets.push_back(m);
+	ctx.vertices.insert(ctx.vertices.end(), meshlet_vertices, meshlet_vertices + meshlet->vertex_count);
+	ctx.triangles.insert(ctx.triangles.end(), meshlet_triangles, meshlet_triangles + meshlet->triangle_count * 3);
+}
+
+static void meshletsStream()
+{
+	const size_t N = 100;
+
+	std::vector<float> vb;
+	std::vector<unsigned int> ib;
+
+	makeGrid(vb, ib, N, 0.1f, 0.1f, 10.f);
+
+	const size_t max_vertices = 64, min_triangles = 32, max_triangles = 96;
+
+	// small windows: every source triangle is emitted exactly once
+	MeshletStreamContext ctx;
+	size_t count = meshopt_buildMeshletsStream(&ib[0], ib.size(), &vb[0], vb.size() / 3, sizeof(float) * 3, max_vertices, min_triangles, max_triangles, 0.25f, 2.f, 1000, meshletStreamCallback, &ctx);
+
+	assert(count == ctx.meshlets.size());
+	assert(count >= ib.size() / 3 / max_triangles);
+
+	std::vector<unsigned int> covered(vb.size() / 3 * 2);
+
+	for (size_t i = 0; i < ctx.meshlets.size(); ++i)
+	{
+		const meshopt_Meshlet& m = ctx.meshlets[i];
+		assert(m.vertex_count <= max_vertices && m.triangle_count >= 1 && m.triangle_count <= max_triangles);
+
+		for (size_t j = 0; j < m.triangle_count; ++j)
+		{
+			unsigned int a = ctx.vertices[m.vertex_offset + ctx.triangles[m.triangle_offset + j * 3 + 0]];
+			unsigned int b = ctx.vertices[m.vertex_offset + ctx.triangles[m.triangle_offset + j * 3 + 1]];
+			unsigned int c = ctx.vertices[m.vertex_offset + ctx.triangles[m.triangle_offset + j * 3 + 2]];
+
+			// each grid vertex is the smallest vertex of at most two triangles, distinguished by the middle vertex
+			unsigned int lo = a < b ? (a < c ? a : c) : (b < c ? b : c);
+			unsigned int hi = a > b ? (a > c ? a : c) : (b > c ? b : c);
+			unsigned int mid = a + b + c - lo - hi;
+
+			covered[lo * 2 + (mid == lo + N)]++;
+		}
+	}
+
+	for (size_t y = 0; y < N; ++y)
+		for (size_t x = 0; x < N; ++x)
+		{
+			size_t v0 = y * (N + 1) + x;
+			assert(covered[v0 * 2 + 0] == 1 && covered[(v0 + 1) * 2 + 1] == 1);
+		}
+
+	// a single window produces the same result as meshopt_buildMeshletsFlex
+	std::vector<meshopt_Meshlet> expected(meshopt_buildMeshletsBound(ib.size(), max_vertices, min_triangles));
+	std::vector<unsigned int> expected_vertices(ib.size());
+	std::vector<unsigned char> expected_triangles(ib.size());
+
+	expected.resize(meshopt_buildMeshletsFlex(&expected[0], &expected_vertices[0], &expected_triangles[0], &ib[0], ib.size(), &vb[0], vb.size() / 3, sizeof(float) * 3, max_vertices, min_triangles, max_triangles, 0.25f, 2.f));
+
+	MeshletStreamContext single;
+	meshopt_buildMeshletsStream(&ib[0], ib.size(), &vb[0], vb.size() / 3, sizeof(float) * 3, max_vertices, min_triangles, max_triangles, 0.25f, 2.f, ib.size() / 3, meshletStreamCallback, &single);
+
+	assert(single.meshlets.size() == expected.size());
+
+	for (size_t i = 0; i < expected.size(); ++i)
+	{
+		const meshopt_Meshlet& e = expected[i];
+		const meshopt_Meshlet& a = single.meshlets[i];
+
+		assert(a.vertex_count == e.vertex_count && a.triangle_count == e.triangle_count);
+		assert(memcmp(&single.vertices[a.vertex_offset], &expected_vertices[e.vertex_offset], e.vertex_count * sizeof(unsigned int)) == 0);
+		assert(memcmp(&single.triangles[a.triangle_offset], &expected_triangles[e.triangle_offset], e.triangle_count * 3) == 0);
+	}
+}
+
+static void meshletsPack()
+{
+	const size_t N = 40;
+
+	std::vector<float> vb;
+	std::vector<unsigned int> ib;
+
+	makeGrid(vb, ib, N, 0.3f, 0.3f, 10.f);
+
+	std::vector<meshopt_Meshlet> meshlets(meshopt_buildMeshletsBound(ib.size(), 64, 32));
+	std::vector<unsigned int> meshlet_vertices(ib.size());
+	std::vector<unsigned char> meshlet_triangles(ib.size());
+
+	meshlets.resize(meshopt_buildMeshletsFlex(&meshlets[0], &meshlet_vertices[0], &meshlet_triangles[0], &ib[0], ib.size(), &vb[0], vb.size() / 3, sizeof(float) * 3, 64, 32, 96, 0.25f, 2.f));
+
+	size_t total_vertices = 0, total_triangles = 0;
+	for (size_t i = 0; i < meshlets.size(); ++i)
+	{
+		total_vertices += meshlets[i].vertex_count;
+		total_triangles += meshlets[i].triangle_count;
+	}
+
+	std::vector<meshopt_PackedMeshlet> packed(meshlets.size());
+	std::vector<meshopt_PackedBounds> bounds(meshlets.size());
+	std::vector<unsigned short> vertices16(total_vertices);
+	std::vector<unsigned int> triangles32(total_triangles);
+
+	meshopt_packMeshlets(&packed[0], &vertices16[0], 2, &triangles32[0], 4, &bounds[0], &meshlets[0], meshlets.size(), &meshlet_vertices[0], &meshlet_triangles[0], &vb[0], vb.size() / 3, sizeof(float) * 3);
+
+	size_t vertex_offset = 0, triangle_offset = 0;
+
+	for (size_t i = 0; i < meshlets.size(); ++i)
+	{
+		const meshopt_Meshlet& m = meshlets[i];
+		const meshopt_PackedMeshlet& p = packed[i];
+
+		assert(p.vertex_offset == vertex_offset && p.triangle_offset == triangle_offset);
+		assert(p.vertex_count == m.vertex_count && p.triangle_count == m.triangle_count);
+
+		for (size_t j = 0; j < m.vertex_count; ++j)
+			assert(vertices16[p.vertex_offset + j] == meshlet_vertices[m.vertex_offset + j]);
+
+		for (size_t j = 0; j < m.triangle_count; ++j)
+		{
+			unsigned int t = triangles32[p.triangle_offset + j];
+			const unsigned char* e = &meshlet_triangles[m.triangle_offset + j * 3];
+
+			assert(t == unsigned(e[0] | (e[1] << 8) | (e[2] << 16)));
+		}
+
+		// quantized sphere must contain all meshlet vertices
+		const meshopt_PackedBounds& b = bounds[i];
+		float cx = meshopt_dequantizeHalf(b.center[0]), cy = meshopt_dequantizeHalf(b.center[1]), cz = meshopt_dequantizeHalf(b.center[2]);
+		float r = meshopt_dequantizeHalf(b.radius);
+
+		for (size_t j = 0; j < m.vertex_count; ++j)
+		{
+			const float* v = &vb[meshlet_vertices[m.vertex_offset + j] * 3];
+			float dx = v[0] - cx, dy = v[1] - cy, dz = v[2] - cz;
+
+			assert(dx * dx + dy * dy + dz * dz <= r * r);
+		}
+
+		meshopt_Bounds eb = meshopt_computeMeshletBounds(&meshlet_vertices[m.vertex_offset], &meshlet_triangles[m.triangle_offset], m.triangle_count, &vb[0], vb.size() / 3, sizeof(float) * 3);
+		assert(b.cone_axis[0] == eb.cone_axis_s8[0] && b.cone_axis[1] == eb.cone_axis_s8[1] && b.cone_axis[2] == eb.cone_axis_s8[2]);
+		assert(b.cone_cutoff == eb.cone_cutoff_s8);
+
+		vertex_offset += m.vertex_count;
+		triangle_offset += m.triangle_count;
+	}
+
+	// in-place packing produces the same data in the source arrays
+	std::vector<unsigned int> inplace_vertices = meshlet_vertices;
+	std::vector<unsigned char> inplace_triangles = meshlet_triangles;
+	std::vector<meshopt_PackedMeshlet> inplace(meshlets.size());
+
+	meshopt_packMeshlets(&inplace[0], &inplace_vertices[0], 2, &inplace_triangles[0], 3, NULL, &meshlets[0], meshlets.size(), &inplace_vertices[0], &inplace_triangles[0], NULL, vb.size() / 3, 0);
+
+	assert(memcmp(&inplace[0], &packed[0], packed.size() * sizeof(meshopt_PackedMeshlet)) == 0);
+	assert(memcmp(&inplace_vertices[0], &vertices16[0], vertices16.size() * 2) == 0);
+
+	for (size_t i = 0; i < triangles32.size(); ++i)
+	{
+		unsigned int t = triangles32[i];
+		assert(inplace_triangles[i * 3 + 0] == (t & 0xff) && inplace_triangles[i * 3 + 1] == ((t >> 8) & 0xff) && inplace_triangles[i * 3 + 2] == (t >> 16));
+	}
+}
+
+static void meshletBoundsBatch()
+{
+	// large enough to produce several batch tasks
+	const size_t N = 150;
+
+	std::vector<float> vb;
+	std::vector<unsigned int> ib;
+
+	makeGrid(vb, ib, N, 0.3f, 0.3f, 10.f);
+
+	std::vector<meshopt_Meshlet> meshlets(meshopt_buildMeshletsBound(ib.size(), 32, 32));
+	std::vector<unsigned int> meshlet_vertices(ib.size());
+	std::vector<unsigned char> meshlet_triangles(ib.size());
+
+	meshlets.resize(meshopt_buildMeshlets(&meshlets[0], &meshlet_vertices[0], &meshlet_triangles[0], &ib[0], ib.size(), &vb[0], vb.size() / 3, sizeof(float) * 3, 32, 32, 0.f));
+	assert(meshlets.size() > 1024);
+
+	std::vector<meshopt_Bounds> expected(meshlets.size());
+
+	for (size_t i = 0; i < meshlets.size(); ++i)
 	{
-		vb[(i + 1) * 3 + 0] = vb[(i + 1) * 3 + 1] = vb[(i + 1) * 3 + 2] = powf(1.2f, float(i));
-
-		ib[i * 3 + 0] = 0;
-		ib[i * 3 + 1] = ib[i * 3 + 2] = unsigned(i + 1);
+		const meshopt_Meshlet& m = meshlets[i];
+		expected[i] = meshopt_computeMeshletBounds(&meshlet_vertices[m.vertex_offset], &meshlet_triangles[m.triangle_offset], m.triangle_count, &vb[0], vb.size() / 3, sizeof(float) * 3);
 	}
 
-	size_t max_meshlets = meshopt_buildMeshletsBound(N * 3, max_vertices, max_triangles);
-	std::vector<meshopt_Meshlet> meshlets(max_meshlets);
-	std::vector<unsigned int> meshlet_vertices(N * 3);
-	std::vector<unsigned char> meshlet_triangles(N * 3);
+	std::vector<meshopt_Bounds> actual(meshlets.size());
 
-	size_t result = meshopt_buildMeshletsSpatial(&meshlets[0], &meshlet_vertices[0], &meshlet_triangles[0], &ib[0], N * 3, &vb[0], N + 1, sizeof(float) * 3, max_vertices, max_triangles, max_triangles, 0.f);
-	assert(result == N);
+	meshopt_computeMeshletBoundsBatch(&actual[0], &meshlets[0], meshlets.size(), &meshlet_vertices[0], &meshlet_triangles[0], &vb[0], vb.size() / 3, sizeof(float) * 3, NULL, NULL);
+	assert(memcmp(&actual[0], &expected[0], actual.size() * sizeof(meshopt_Bounds)) == 0);
+
+	memset(&actual[0], 0, actual.size() * sizeof(meshopt_Bounds));
+
+	meshopt_computeMeshletBoundsBatch(&actual[0], &meshlets[0], meshlets.size(), &meshlet_vertices[0], &meshlet_triangles[0], &vb[0], vb.size() / 3, sizeof(float) * 3, dispatchReverse, NULL);
+	assert(memcmp(&actual[0], &expected[0], actual.size() * sizeof(meshopt_Bounds)) == 0);
 }
 
 static void partitionBasic()
@@ -2664,6 +3464,519 @@ static void simplifyUpdateLocked(unsigned int options)
 	assert(vb[3][3] == 0.2f);
 }
 
+static void simplifyLevels()
+{
+	const size_t N = 20;
+
+	std::vector<float> vb;
+	std::vector<unsigned int> ib;
+
+	makeGrid(vb, ib, N, 0.4f, 0.3f, 1.f);
+
+	const size_t levels = 3;
+	size_t targets[levels] = {ib.size() / 2, ib.size() / 4, ib.size() / 10};
+	float errors[levels] = {1e-2f, 1e-1f, 1.f};
+
+	for (int k = 0; k < 2; ++k)
+	{
+		unsigned int options = k == 0 ? 0 : meshopt_SimplifySparse;
+
+		std::vector<unsigned int> lods[levels];
+		unsigned int* destinations[levels];
+		for (size_t i = 0; i < levels; ++i)
+		{
+			lods[i].resize(ib.size());
+			destinations[i] = &lods[i][0];
+		}
+
+		size_t counts[levels] = {};
+		float result_errors[levels] = {};
+		size_t last = meshopt_simplifyLevels(destinations, counts, &ib[0], ib.size(), &vb[0], vb.size() / 3, sizeof(float) * 3, NULL, 0, NULL, 0, NULL, targets, errors, levels, options, result_errors);
+		assert(last == counts[levels - 1]);
+
+		// first level is simplified from the original mesh, so it must match the regular simplifier
+		std::vector<unsigned int> expected(ib.size());
+		float expected_error = 0;
+		expected.resize(meshopt_simplify(&expected[0], &ib[0], ib.size(), &vb[0], vb.size() / 3, sizeof(float) * 3, targets[0], errors[0], options, &expected_error));
+
+		assert(counts[0] == expected.size());
+		assert(memcmp(&lods[0][0], &expected[0], expected.size() * sizeof(unsigned int)) == 0);
+		assert(result_errors[0] == expected_error);
+
+		// levels are nested: each level only uses vertices that are present in the previous level
+		for (size_t i = 1; i < levels; ++i)
+		{
+			assert(counts[i] <= counts[i - 1] && counts[i] <= targets[i]);
+			assert(result_errors[i] >= result_errors[i - 1] && result_errors[i] <= errors[i]);
+
+			std::vector<unsigned char> used(vb.size() / 3);
+			for (size_t j = 0; j < counts[i - 1]; ++j)
+				used[lods[i - 1][j]] = 1;
+
+			for (size_t j = 0; j < counts[i]; ++j)
+				assert(used[lods[i][j]]);
+		}
+
+		assert(counts[levels - 1] < counts[0]);
+	}
+}
+
+static void simplifyParallel()
+{
+	// grid large enough to span multiple tasks
+	const size_t N = 200;
+
+	std::vector<float> vb;
+	std::vector<unsigned int> ib;
+
+	makeSeamGrid(vb, ib, N, 0.2f, 0.15f);
+
+	const float attr_weights[2] = {0.5f, 0.5f};
+
+	for (int k = 0; k < 3; ++k)
+	{
+		size_t attribute_count = k == 0 ? 0 : 2;
+		unsigned int options = k == 2 ? meshopt_SimplifyPrune | meshopt_SimplifySparse : 0;
+
+		std::vector<unsigned int> expected(ib.size());
+		float expected_error = 0;
+		expected.resize(meshopt_simplifyWithAttributes(&expected[0], &ib[0], ib.size(), &vb[0], vb.size() / 5, sizeof(float) * 5, &vb[3], sizeof(float) * 5, attr_weights, attribute_count, NULL, ib.size() / 10, 1e-1f, options, &expected_error));
+
+		std::vector<unsigned int> actual(ib.size());
+		float actual_error = 0;
+		actual.resize(meshopt_simplifyParallel(&actual[0], &ib[0], ib.size(), &vb[0], vb.size() / 5, sizeof(float) * 5, &vb[3], sizeof(float) * 5, attr_weights, attribute_count, NULL, ib.size() / 10, 1e-1f, options, &actual_error, dispatchReverse, NULL));
+
+		assert(actual.size() == expected.size() && actual.size() < ib.size() / 2);
+		assert(memcmp(&actual[0], &expected[0], actual.size() * sizeof(unsigned int)) == 0);
+		assert(actual_error == expected_error);
+	}
+}
+
+static void simplifyTiled()
+{
+	const size_t N = 100;
+
+	std::vector<float> vb;
+	std::vector<unsigned int> ib;
+
+	makeGrid(vb, ib, N, 0.f, 0.f, 0.f);
+
+	// the first pass locks tile boundaries; later passes should simplify the seams and reach the target
+	std::vector<unsigned int> lod(ib.size());
+	float error = 0;
+	lod.resize(meshopt_simplifyTiled(&lod[0], &ib[0], ib.size(), &vb[0], vb.size() / 3, sizeof(float) * 3, NULL, 0, NULL, 0, NULL, ib.size() / 20, 1e-2f, 0, 500, &error));
+
+	assert(lod.size() <= ib.size() / 20);
+	assert(error < 1e-2f);
+
+	// planar grid should keep its area as collapses are restricted to the plane and the border
+	float area = 0;
+	for (size_t i = 0; i < lod.size(); i += 3)
+	{
+		const float* a = &vb[lod[i + 0] * 3];
+		const float* b = &vb[lod[i + 1] * 3];
+		const float* c = &vb[lod[i + 2] * 3];
+
+		area += ((b[0] - a[0]) * (c[1] - a[1]) - (b[1] - a[1]) * (c[0] - a[0])) * 0.5f;
+	}
+
+	assert(fabsf(area - float(N * N)) < 1e-2f);
+
+	// with locked border in a single tile, results match the regular simplifier
+	std::vector<unsigned int> expected(ib.size());
+	expected.resize(meshopt_simplify(&expected[0], &ib[0], ib.size(), &vb[0], vb.size() / 3, sizeof(float) * 3, ib.size() / 4, 1e-2f, meshopt_SimplifyLockBorder | meshopt_SimplifySparse | meshopt_SimplifyErrorAbsolute));
+
+	std::vector<unsigned int> actual(ib.size());
+	actual.resize(meshopt_simplifyTiled(&actual[0], &ib[0], ib.size(), &vb[0], vb.size() / 3, sizeof(float) * 3, NULL, 0, NULL, 0, NULL, ib.size() / 4, 1e-2f, meshopt_SimplifyLockBorder | meshopt_SimplifyErrorAbsolute, ib.size() / 3, NULL));
+
+	assert(actual.size() == expected.size());
+	assert(memcmp(&actual[0], &expected[0], actual.size() * sizeof(unsigned int)) == 0);
+}
+
+static void simplifyTiledSeams()
+{
+	const size_t N = 100, C = 25;
+
+	std::vector<float> vb;
+	std::vector<unsigned int> ib;
+
+	// 4x4 charts with separate vertices; positions along chart boundaries are shared, but vertex indices are not
+	for (size_t cy = 0; cy < N / C; ++cy)
+		for (size_t cx = 0; cx < N / C; ++cx)
+		{
+			unsigned int base = unsigned(vb.size() / 5);
+
+			for (size_t y = 0; y <= C; ++y)
+				for (size_t x = 0; x <= C; ++x)
+				{
+					float px = float(cx * C + x), py = float(cy * C + y);
+
+					vb.push_back(px);
+					vb.push_back(py);
+					vb.push_back(sinf(px * 0.2f) * cosf(py * 0.15f));
+					vb.push_back(float(x) / float(C));
+					vb.push_back(float(y) / float(C));
+				}
+
+			size_t offset = ib.size();
+			makeGridIndices(ib, C);
+
+			for (size_t i = offset; i < ib.size(); ++i)
+				ib[i] += base;
+		}
+
+	const float attr_weights[2] = {0.5f, 0.5f};
+	const size_t vertex_count = vb.size() / 5;
+
+	const size_t tile_sizes[] = {5000, 2000, 1000};
+
+	for (size_t k = 0; k < sizeof(tile_sizes) / sizeof(tile_sizes[0]); ++k)
+	{
+		std::vector<unsigned int> lod(ib.size());
+		lod.resize(meshopt_simplifyTiled(&lod[0], &ib[0], ib.size(), &vb[0], vertex_count, sizeof(float) * 5, &vb[3], sizeof(float) * 5, attr_weights, 2, NULL, ib.size() / 10, 1e-1f, 0, tile_sizes[k], NULL));
+
+		assert(lod.size() <= ib.size() / 10);
+
+		// copies of a vertex in different charts must be locked together at tile boundaries, otherwise the seams crack open
+		assert(countOpenInteriorEdges(&lod[0], lod.size(), &ib[0], ib.size(), &vb[0], vertex_count, sizeof(float) * 5) == 0);
+	}
+}
+
+static void simplifyProgressive()
+{
+	const size_t N = 20;
+
+	std::vector<float> vb;
+	std::vector<unsigned int> ib;
+
+	makeSeamGrid(vb, ib, N, 0.4f, 0.3f);
+
+	const float attr_weights[2] = {0.5f, 0.5f};
+	const size_t vertex_count = vb.size() / 5;
+
+	for (int k = 0; k < 2; ++k)
+	{
+		// sparse simplification uses a subset of the mesh, but collapses still reference original vertices
+		size_t index_count = k == 0 ? ib.size() : ib.size() / 2;
+		unsigned int options = k == 0 ? 0 : meshopt_SimplifySparse;
+
+		std::vector<unsigned int> expected(index_count);
+		float expected_error = 0;
+		expected.resize(meshopt_simplifyWithAttributes(&expected[0], &ib[0], index_count, &vb[0], vertex_count, sizeof(float) * 5, &vb[3], sizeof(float) * 5, attr_weights, 2, NULL, index_count / 10, 1e-1f, options, &expected_error));
+
+		std::vector<meshopt_VertexCollapse> collapses(vertex_count);
+		float result_error = 0;
+		collapses.resize(meshopt_simplifyProgressive(&collapses[0], &ib[0], index_count, &vb[0], vertex_count, sizeof(float) * 5, &vb[3], sizeof(float) * 5, attr_weights, 2, NULL, index_count / 10, 1e-1f, options, &result_error));
+
+		assert(result_error == expected_error);
+		assert(!collapses.empty() && collapses.back().error <= result_error);
+
+		for (size_t i = 1; i < collapses.size(); ++i)
+			assert(collapses[i].error >= collapses[i - 1].error);
+
+		// each group moves all wedges of one position and shares the error
+		assert(collapses.back().group == 1);
+
+		for (size_t i = 0; i + 1 < collapses.size(); ++i)
+		{
+			assert(collapses[i].group >= 1);
+
+			if (collapses[i].group > 1)
+			{
+				assert(collapses[i + 1].group == collapses[i].group - 1);
+				assert(collapses[i + 1].error == collapses[i].error);
+				assert(memcmp(&vb[collapses[i + 1].vertex * 5], &vb[collapses[i].vertex * 5], sizeof(float) * 3) == 0);
+			}
+		}
+
+		// applying the entire sequence must match the regular simplifier
+		std::vector<unsigned int> actual(index_count);
+		actual.resize(meshopt_generateProgressiveIndices(&actual[0], &ib[0], index_count, vertex_count, &collapses[0], collapses.size()));
+
+		assert(actual.size() == expected.size());
+		assert(memcmp(&actual[0], &expected[0], actual.size() * sizeof(unsigned int)) == 0);
+
+		// prefixes that end at group boundaries refine the mesh continuously and never open seams
+		size_t last = index_count;
+
+		for (size_t i = 0; i <= collapses.size(); i += i < collapses.size() ? collapses[i].group : 1)
+		{
+			std::vector<unsigned int> lod(index_count);
+			size_t count = meshopt_generateProgressiveIndices(&lod[0], &ib[0], index_count, vertex_count, &collapses[0], i);
+
+			assert(count <= last && count >= expected.size());
+			last = count;
+
+			assert(countOpenInteriorEdges(&lod[0], count, &ib[0], index_count, &vb[0], vertex_count, sizeof(float) * 5) == 0);
+		}
+	}
+}
+
+static void simplifyContext()
+{
+	const size_t N = 20;
+
+	std::vector<float> vb;
+	std::vector<unsigned int> ib;
+
+	makeSeamGrid(vb, ib, N, 0.4f, 0.3f);
+
+	const float attr_weights[3][2] = {{0.5f, 0.5f}, {0.f, 2.f}, {0.f, 0.f}};
+	const size_t vertex_count = vb.size() / 5;
+
+	for (int k = 0; k < 2; ++k)
+	{
+		size_t index_count = k == 0 ? ib.size() : ib.size() / 2;
+		unsigned int options = k == 0 ? meshopt_SimplifyPrune : meshopt_SimplifySparse;
+
+		meshopt_SimplifyContext* context = meshopt_simplifyContextCreate(&ib[0], index_count, &vb[0], vertex_count, sizeof(float) * 5, &vb[3], sizeof(float) * 5, 2, NULL, options);
+
+		// every run must match the regular simplifier regardless of the runs before it
+		for (int w = 0; w < 3; ++w)
+			for (size_t target = index_count; target > 0; target /= 4)
+			{
+				std::vector<unsigned int> expected(index_count);
+				float expected_error = 0;
+				expected.resize(meshopt_simplifyWithAttributes(&expected[0], &ib[0], index_count, &vb[0], vertex_count, sizeof(float) * 5, &vb[3], sizeof(float) * 5, attr_weights[w], 2, NULL, target, 1e-1f, options, &expected_error));
+
+				std::vector<unsigned int> actual(index_count);
+				float actual_error = 0;
+				actual.resize(meshopt_simplifyWithContext(&actual[0], context, attr_weights[w], target, 1e-1f, &actual_error));
+
+				assert(actual.size() == expected.size());
+				assert(actual.empty() || memcmp(&actual[0], &expected[0], actual.size() * sizeof(unsigned int)) == 0);
+				assert(actual_error == expected_error);
+			}
+
+		meshopt_simplifyContextDestroy(context);
+	}
+}
+
+static size_t trackedMemory;
+static size_t trackedPeak;
+
+static void* trackedAlloc(size_t size)
+{
+	trackedMemory += size;
+	trackedPeak = trackedPeak < trackedMemory ? trackedMemory : trackedPeak;
+
+	size_t* ptr = static_cast<size_t*>(malloc(size + 16));
+	*ptr = size;
+	return ptr + 16 / sizeof(size_t);
+}
+
+static void trackedFree(void* ptr)
+{
+	size_t* base = static_cast<size_t*>(ptr) - 16 / sizeof(size_t);
+	trackedMemory -= *base;
+
+	free(base);
+}
+
+static void simplifyBudget()
+{
+	const size_t N = 40;
+
+	std::vector<float> vb;
+	std::vector<unsigned int> ib;
+
+	// 8 attributes that are mostly derived from two independent signals
+	for (size_t y = 0; y <= N; ++y)
+		for (size_t x = 0; x <= N; ++x)
+		{
+			float u = float(x) / float(N), v = float(y) / float(N);
+			float attrs[8] = {u, v, u + v, u - v, sinf(u * 3), cosf(v * 3), u * 0.5f + 0.25f, sinf(u * 3) + v * 0.01f};
+
+			vb.push_back(float(x));
+			vb.push_back(float(y));
+			vb.push_back(sinf(float(x) * 0.3f) * cosf(float(y) * 0.2f));
+			vb.insert(vb.end(), attrs, attrs + 8);
+		}
+
+	makeGridIndices(ib, N);
+
+	const float attr_weights[8] = {1, 1, 0.5f, 0.5f, 1, 1, 0, 0.5f};
+	const size_t vertex_count = vb.size() / 11;
+	const size_t target = ib.size() / 8;
+
+	std::vector<unsigned int> expected(ib.size());
+	float expected_error = 0;
+	expected.resize(meshopt_simplifyWithAttributes(&expected[0], &ib[0], ib.size(), &vb[0], vertex_count, sizeof(float) * 11, &vb[3], sizeof(float) * 11, attr_weights, 8, NULL, target, 1.f, 0, &expected_error));
+
+	meshopt_setAllocator(trackedAlloc, trackedFree);
+
+	// unlimited budget matches the regular simplifier
+	std::vector<unsigned int> actual(ib.size());
+	float actual_error = 0;
+	size_t full_memory = 0;
+
+	trackedPeak = 0;
+	actual.resize(meshopt_simplifyWithBudget(&actual[0], &ib[0], ib.size(), &vb[0], vertex_count, sizeof(float) * 11, &vb[3], sizeof(float) * 11, attr_weights, 8, NULL, target, 1.f, 0, ~size_t(0), &actual_error, &full_memory));
+
+	assert(actual.size() == expected.size());
+	assert(memcmp(&actual[0], &expected[0], actual.size() * sizeof(unsigned int)) == 0);
+	assert(actual_error == expected_error);
+	assert(trackedPeak > 0 && trackedPeak <= full_memory);
+
+	// smaller budgets reduce the number of attribute components, down to positions only
+	size_t last_memory = full_memory;
+
+	for (int k = 1; k <= 8; ++k)
+	{
+		size_t budget = full_memory - full_memory * k / 16;
+		size_t memory = 0;
+
+		trackedPeak = 0;
+		size_t count = meshopt_simplifyWithBudget(&actual[0], &ib[0], ib.size(), &vb[0], vertex_count, sizeof(float) * 11, &vb[3], sizeof(float) * 11, attr_weights, 8, NULL, target, 1.f, 0, budget, &actual_error, &memory);
+
+		assert(count > 0 && count <= target);
+		assert(trackedPeak <= memory);
+		assert(memory <= last_memory);
+		last_memory = memory;
+	}
+
+	assert(last_memory < full_memory * 2 / 3);
+
+	meshopt_setAllocator(operator new, operator delete);
+	assert(trackedMemory == 0);
+}
+
+static void simplifyBatch()
+{
+	// grids of different sizes with 2 attributes; the first one is large enough to be a separate task
+	const size_t sizes[] = {80, 10, 4, 10};
+	const size_t mesh_count = sizeof(sizes) / sizeof(sizes[0]);
+
+	std::vector<float> vbs[mesh_count];
+	std::vector<unsigned int> ibs[mesh_count];
+
+	for (size_t m = 0; m < mesh_count; ++m)
+	{
+		size_t N = sizes[m];
+
+		for (size_t y = 0; y <= N; ++y)
+			for (size_t x = 0; x <= N; ++x)
+			{
+				vbs[m].push_back(float(x));
+				vbs[m].push_back(float(y));
+				vbs[m].push_back(sinf(float(x) * 0.4f + float(m)) * cosf(float(y) * 0.3f));
+				vbs[m].push_back(float(x) / float(N));
+				vbs[m].push_back(float(y) / float(N));
+			}
+
+		makeGridIndices(ibs[m], N);
+	}
+
+	const float attr_weights[2] = {0.5f, 0.5f};
+
+	std::vector<unsigned int> results[mesh_count];
+	meshopt_SimplifyBatchMesh meshes[mesh_count] = {};
+
+	for (size_t m = 0; m < mesh_count; ++m)
+	{
+		results[m].resize(ibs[m].size());
+
+		meshopt_SimplifyBatchMesh& mesh = meshes[m];
+		mesh.destination = &results[m][0];
+		mesh.indices = &ibs[m][0];
+		mesh.index_count = ibs[m].size();
+		mesh.vertex_positions = &vbs[m][0];
+		mesh.vertex_count = vbs[m].size() / 5;
+		mesh.vertex_positions_stride = sizeof(float) * 5;
+		mesh.vertex_attributes = m % 2 ? &vbs[m][3] : NULL;
+		mesh.vertex_attributes_stride = m % 2 ? sizeof(float) * 5 : 0;
+		mesh.attribute_weights = m % 2 ? attr_weights : NULL;
+		mesh.attribute_count = m % 2 ? 2 : 0;
+		mesh.target_index_count = ibs[m].size() / (m + 2) / 3 * 3;
+		mesh.target_error = 1e-1f;
+	}
+
+	for (int k = 0; k < 2; ++k)
+	{
+		size_t counts[mesh_count] = {};
+		float errors[mesh_count] = {};
+
+		size_t total = meshopt_simplifyBatch(counts, errors, meshes, mesh_count, meshopt_SimplifyLockBorder, k == 0 ? NULL : dispatchReverse, NULL);
+
+		size_t expected_total = 0;
+
+		for (size_t m = 0; m < mesh_count; ++m)
+		{
+			const meshopt_SimplifyBatchMesh& mesh = meshes[m];
+
+			std::vector<unsigned int> expected(mesh.index_count);
+			float expected_error = 0;
+			expected.resize(meshopt_simplifyWithAttributes(&expected[0], mesh.indices, mesh.index_count, mesh.vertex_positions, mesh.vertex_count, mesh.vertex_positions_stride, mesh.vertex_attributes, mesh.vertex_attributes_stride, mesh.attribute_weights, mesh.attribute_count, NULL, mesh.target_index_count, mesh.target_error, meshopt_SimplifyLockBorder, &expected_error));
+
+			assert(counts[m] == expected.size());
+			assert(counts[m] > 0 && memcmp(&results[m][0], &expected[0], counts[m] * sizeof(unsigned int)) == 0);
+			assert(errors[m] == expected_error);
+
+			expected_total += expected.size();
+		}
+
+		assert(total == expected_total);
+	}
+
+	// empty batch is valid
+	assert(meshopt_simplifyBatch(NULL, NULL, NULL, 0, 0, dispatchReverse, NULL) == 0);
+}
+
+static void simplifySloppyParallel()
+{
+	// large enough to split triangle counting into several tasks per grid size
+	const size_t N = 130;
+
+	std::vector<float> vb;
+	std::vector<unsigned int> ib;
+
+	makeGrid(vb, ib, N, 0.1f, 0.1f, 10.f);
+
+	const size_t vertex_count = vb.size() / 3;
+	const float target_errors[] = {1.f, 1e-2f};
+
+	for (size_t k = 0; k < 6; ++k)
+	{
+		size_t target_index_count = ib.size() / (k / 2 == 0 ? 2 : (k / 2 == 1 ? 10 : 100)) / 3 * 3;
+		float target_error = target_errors[k % 2];
+
+		std::vector<unsigned int> expected(ib.size());
+		float expected_error = 0;
+		expected.resize(meshopt_simplifySloppyParallel(&expected[0], &ib[0], ib.size(), &vb[0], vertex_count, sizeof(float) * 3, NULL, target_index_count, target_error, &expected_error, NULL, NULL));
+
+		// error limit may prevent reaching the target, in which case the result should match the serial simplifier since the grid size is fixed
+		std::vector<unsigned int> serial(ib.size());
+		serial.resize(meshopt_simplifySloppy(&serial[0], &ib[0], ib.size(), &vb[0], vertex_count, sizeof(float) * 3, NULL, target_index_count, target_error));
+
+		assert(expected.size() > 0);
+		assert(expected.size() <= target_index_count || (serial.size() == expected.size() && memcmp(&serial[0], &expected[0], serial.size() * sizeof(unsigned int)) == 0));
+
+		// results don't depend on the dispatch order
+		std::vector<unsigned int> actual(ib.size());
+		float actual_error = 0;
+		actual.resize(meshopt_simplifySloppyParallel(&actual[0], &ib[0], ib.size(), &vb[0], vertex_count, sizeof(float) * 3, NULL, target_index_count, target_error, &actual_error, dispatchReverse, NULL));
+
+		assert(actual.size() == expected.size());
+		assert(memcmp(&actual[0], &expected[0], actual.size() * sizeof(unsigned int)) == 0);
+		assert(actual_error == expected_error);
+	}
+
+	// locked vertices are handled the same way as in the serial simplifier
+	unsigned int lib[] = {0, 2, 1, 1, 2, 3, 3, 2, 4, 2, 5, 4};
+	float lvb[] = {0, 4, 0, 0, 1, 0, 2, 2, 0, 0, 0, 0, 1, 0, 0, 4, 0, 0};
+	unsigned char locks[] = {1, 0, 1, 0, 0, 1};
+
+	unsigned int expected[] = {0, 2, 1, 1, 2, 5};
+
+	float error;
+	assert(meshopt_simplifySloppyParallel(lib, lib, 12, lvb, 6, 12, locks, 3, 1.f, &error, dispatchReverse, NULL) == 6);
+	assert(error == 0.f);
+	assert(memcmp(lib, expected, sizeof(expected)) == 0);
+
+	// simplifying down to 0 triangles results in 0 immediately
+	assert(meshopt_simplifySloppyParallel(NULL, lib, 3, lvb, 6, 12, NULL, 0, 0.f, NULL, dispatchReverse, NULL) == 0);
+}
+
 static void filterTriangles()
 {
 	// v0/v3 match fully; v0/v4 match on prefix only
@@ -3186,6 +4499,118 @@ static void decodeMeshletTypical()
 	assert(memcmp(rt, triangles, sizeof(triangles)) == 0);
 }
 
+static void decodeMeshletBatch()
+{
+	const size_t N = 10;
+
+	std::vector<unsigned int> indices;
+	std::vector<float> positions;
+
+	makeGrid(positions, indices, N, 0.f, 0.f, 0.f);
+
+	std::vector<meshopt_Meshlet> meshlets(meshopt_buildMeshletsBound(indices.size(), 16, 15));
+	std::vector<unsigned int> meshlet_vertices(indices.size());
+	std::vector<unsigned char> meshlet_triangles(indices.size());
+
+	meshlets.resize(meshopt_buildMeshlets(&meshlets[0], &meshlet_vertices[0], &meshlet_triangles[0], &indices[0], indices.size(), &positions[0], positions.size() / 3, sizeof(float) * 3, 16, 15, 0.f));
+	assert(meshlets.size() > 10);
+
+	const meshopt_Meshlet& last = meshlets.back();
+
+	meshlet_vertices.resize(last.vertex_offset + last.vertex_count);
+	meshlet_triangles.resize(last.triangle_offset + last.triangle_count * 3);
+
+	std::vector<unsigned char> buffer;
+	std::vector<unsigned int> buffer_offsets(1, 0);
+
+	for (size_t i = 0; i < meshlets.size(); ++i)
+	{
+		const meshopt_Meshlet& m = meshlets[i];
+
+		unsigned char enc[1024];
+		size_t size = meshopt_encodeMeshlet(enc, sizeof(enc), &meshlet_vertices[m.vertex_offset], m.vertex_count, &meshlet_triangles[m.triangle_offset], m.triangle_count);
+		assert(size > 0);
+
+		buffer.insert(buffer.end(), enc, enc + size);
+		buffer_offsets.push_back(unsigned(buffer.size()));
+	}
+
+	// batch decoding must match decoding meshlets one by one; outputs have 3 bytes of padding for the last meshlet
+	std::vector<unsigned int> rv(meshlet_vertices.size() + 1), ev(16);
+	std::vector<unsigned char> rt(meshlet_triangles.size() + 3), et(16 * 3);
+
+	assert(meshopt_decodeMeshletBatch(&rv[0], 4, &rt[0], 3, &meshlets[0], meshlets.size(), &buffer[0], buffer.size(), &buffer_offsets[0]) == 0);
+
+	for (size_t i = 0; i < meshlets.size(); ++i)
+	{
+		const meshopt_Meshlet& m = meshlets[i];
+
+		assert(meshopt_decodeMeshlet(&ev[0], m.vertex_count, &et[0], m.triangle_count, &buffer[buffer_offsets[i]], buffer_offsets[i + 1] - buffer_offsets[i]) == 0);
+		assert(memcmp(&rv[m.vertex_offset], &ev[0], m.vertex_count * 4) == 0);
+		assert(memcmp(&rt[m.triangle_offset], &et[0], m.triangle_count * 3) == 0);
+	}
+
+	// 16-bit vertices and packed 32-bit triangles
+	std::vector<unsigned short> rvs(meshlet_vertices.size() + 1);
+	std::vector<unsigned int> rtp(meshlet_triangles.size() / 3);
+
+	assert(meshopt_decodeMeshletBatch(&rvs[0], 2, &rtp[0], 4, &meshlets[0], meshlets.size(), &buffer[0], buffer.size(), &buffer_offsets[0]) == 0);
+
+	for (size_t i = 0; i < meshlet_vertices.size(); ++i)
+		assert(rvs[i] == rv[i]);
+
+	for (size_t i = 0; i < rtp.size(); ++i)
+		assert(rtp[i] == unsigned(rt[i * 3 + 0] | (rt[i * 3 + 1] << 8) | (rt[i * 3 + 2] << 16)));
+
+	// truncated or inconsistent spans are rejected
+	assert(meshopt_decodeMeshletBatch(&rv[0], 4, &rt[0], 3, &meshlets[0], meshlets.size(), &buffer[0], buffer.size() - 1, &buffer_offsets[0]) < 0);
+
+	buffer_offsets[1]--;
+	assert(meshopt_decodeMeshletBatch(&rv[0], 4, &rt[0], 3, &meshlets[0], meshlets.size(), &buffer[0], buffer.size(), &buffer_offsets[0]) < 0);
+}
+
+static void decodeMeshletSimdLevel()
+{
+	unsigned int vertices[64];
+	unsigned char triangles[64 * 3];
+
+	// all vertex/triangle counts up to 64 cover group pairs and tails of every length
+	for (size_t count = 3; count <= 64; ++count)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			unsigned int h = unsigned(i) * 0x9e3779b9u;
+
+			vertices[i] = (i % 5 == 0) ? h : (i % 3 == 0 ? h >> 24 : unsigned(i) * 7 + (h >> 20));
+
+			triangles[i * 3 + 0] = (unsigned char)(i);
+			triangles[i * 3 + 1] = (unsigned char)((i + 1 + (h >> 28)) % count);
+			triangles[i * 3 + 2] = (unsigned char)((i + count - 1) % count);
+		}
+
+		unsigned char enc[1024];
+		size_t size = meshopt_encodeMeshlet(enc, sizeof(enc), vertices, count, triangles, count);
+		assert(size > 0);
+
+		for (int level = 0; level <= 2; ++level)
+		{
+			int actual = meshopt_decodeMeshletSimdLevel(level);
+			assert(actual >= 0 && actual <= 2);
+
+			validateDecodeMeshlet<unsigned int, unsigned int, 64, 64>(enc, size, vertices, count, triangles, count);
+			validateDecodeMeshlet<unsigned short, unsigned char, 64, 64 * 3>(enc, size, vertices, count, triangles, count);
+
+			// truncated input must be rejected by every decoder
+			unsigned int rv[64];
+			unsigned int rt[64];
+			assert(meshopt_decodeMeshlet(rv, count, 4, rt, count, 4, enc + 1, size - 1) < 0);
+		}
+	}
+
+	// restore default (highest supported) level
+	meshopt_decodeMeshletSimdLevel(2);
+}
+
 static void opacityMap()
 {
 	const size_t triangle_count = 6;
@@ -3551,6 +4976,7 @@ void runTests()
 	decodeIndexMalformedVByte();
 	roundtripIndexTricky();
 	encodeIndexEmpty();
+	decodeIndexParallel();
 
 	decodeIndexSequence();
 	decodeIndexSequence16();
@@ -3582,6 +5008,12 @@ void runTests()
 		decodeVertexBitXor();
 		decodeVertexLarge();
 		decodeVertexSmall();
+		decodeVertexSimdLevel();
+		encodeVertexParallel();
+		decodeVertexRange();
+		decodeVertexFiltered();
+		decodeVertexRef();
+		encodeVertexStream();
 		encodeVertexEmpty();
 		encodeVertexMemorySafe();
 	}
@@ -3617,6 +5049,11 @@ void runTests()
 	meshletsMax();
 	meshletsSpatial();
 	meshletsSpatialDeep();
+	meshletsParallel();
+	meshletsSpatialParallel();
+	meshletsStream();
+	meshletsPack();
+	meshletBoundsBatch();
 
 	partitionBasic();
 	partitionSpatial();
@@ -3653,6 +5090,15 @@ void runTests()
 	simplifyUpdate();
 	simplifyUpdateLocked(0);
 	simplifyUpdateLocked(meshopt_SimplifySparse);
+	simplifyLevels();
+	simplifyParallel();
+	simplifyTiled();
+	simplifyTiledSeams();
+	simplifyProgressive();
+	simplifyContext();
+	simplifyBudget();
+	simplifyBatch();
+	simplifySloppyParallel();
 
 	filterTriangles();
 	adjacency();
@@ -3668,6 +5114,8 @@ void runTests()
 	decodeMeshletSafety();
 	decodeMeshletBasic();
 	decodeMeshletTypical();
+	decodeMeshletBatch();
+	decodeMeshletSimdLevel();
 
 	opacityMap();
 	opacityMapRasterize0();
@@ -762,6 +762,26 @@ static void radixPass(unsigned int* destination, const unsigned int* source, con
 	}
 }
 
+static void bvhSortAxis(unsigned int* order, const float* keys, unsigned int* temp, size_t face_count)
+{
+	unsigned int hist[1024][3];
+	computeHistogram(hist, keys, face_count);
+
+	// 3-pass radix sort computes the resulting order into axes
+	for (size_t i = 0; i < face_count; ++i)
+		temp[i] = unsigned(i);
+
+	radixPass(order, temp, keys, face_count, hist, 0);
+	radixPass(temp, order, keys, face_count, hist, 1);
+	radixPass(order, temp, keys, face_count, hist, 2);
+}
+
+static void bvhSortAxes(unsigned int* axes, const float* centroids, unsigned int* temp, size_t face_count)
+{
+	for (int k = 0; k < 3; ++k)
+		bvhSortAxis(axes + k * face_count, centroids + k * face_count, temp, face_count);
+}
+
 static void bvhPrepare(BVHBox* boxes, float* centroids, const unsigned int* indices, size_t face_count, const float* vertex_positions, size_t vertex_count, size_t vertex_stride_float)
 {
 	(void)vertex_count;
@@ -921,6 +941,23 @@ static size_t bvhPivot(const float* areas, const unsigned int* vertices, size_t
 	return bestsplit;
 }
 
+static size_t bvhPivotAxis(void* scratch, const BVHBox* boxes, const unsigned int* order, size_t count, short* used, const unsigned int* indices, size_t step, size_t min, size_t max, float fill, size_t maxfill, float* out_cost)
+{
+	float* areas = static_cast<float*>(scratch);
+	unsigned int* vertices = NULL;
+
+	bvhComputeArea(areas, boxes, order, count);
+
+	if (count <= max)
+	{
+		// for vertex bound clusters, count number of unique vertices for each split
+		vertices = reinterpret_cast<unsigned int*>(areas + 2 * count);
+		bvhCountVertices(order, count, used, indices, vertices);
+	}
+
+	return bvhPivot(areas, vertices, count, step, min, max, fill, maxfill, out_cost);
+}
+
 static void bvhPartition(unsigned int* target, const unsigned int* order, const unsigned char* sides, size_t split, size_t count)
 {
 	size_t l = 0, r = split;
@@ -958,20 +995,8 @@ static void bvhSplit(const BVHBox* boxes, unsigned int* orderx, unsigned int* or
 
 	for (int k = 0; k < 3; ++k)
 	{
-		float* areas = static_cast<float*>(scratch);
-		unsigned int* vertices = NULL;
-
-		bvhComputeArea(areas, boxes, axes[k], count);
-
-		if (count <= max_triangles)
-		{
-			// for vertex bound clusters, count number of unique vertices for each split
-			vertices = reinterpret_cast<unsigned int*>(areas + 2 * count);
-			bvhCountVertices(axes[k], count, used, indices, vertices);
-		}
-
 		float axiscost = FLT_MAX;
-		size_t axissplit = bvhPivot(areas, vertices, count, step, mint, max_triangles, fill_weight, maxfill, &axiscost);
+		size_t axissplit = bvhPivotAxis(scratch, boxes, axes[k], count, used, indices, step, mint, max_triangles, fill_weight, maxfill, &axiscost);
 
 		if (axissplit && axiscost < bestcost)
 		{
@@ -1012,6 +1037,377 @@ static void bvhSplit(const BVHBox* boxes, unsigned int* orderx, unsigned int* or
 	bvhSplit(boxes, orderx + bestsplit, ordery + bestsplit, orderz + bestsplit, boundary + bestsplit, count - bestsplit, depth + 1, scratch, used, indices, max_vertices, min_triangles, max_triangles, fill_weight);
 }
 
+// Parallel meshlet construction splits the mesh into spatially coherent chunks of at most this many triangles that are clusterized independently
+// since chunks are split at the median, each chunk has more than half as many triangles unless the entire mesh fits into one chunk
+const size_t kMeshletChunkSize = 32768;
+
+static void partitionChunks(size_t* chunk_offsets, size_t& chunk_count, const float* centroids, size_t face_count, unsigned int* orderx, unsigned int* ordery, unsigned int* orderz, size_t offset, size_t count, unsigned char* sides, unsigned int* temp)
+{
+	if (count <= kMeshletChunkSize)
+	{
+		chunk_offsets[chunk_count++] = offset;
+		return;
+	}
+
+	unsigned int* axes[3] = {orderx, ordery, orderz};
+
+	// split along the axis with the largest centroid extent; orders are sorted so the extent is defined by the first and last triangle
+	int bestk = 0;
+	float bestextent = -FLT_MAX;
+
+	for (int k = 0; k < 3; ++k)
+	{
+		float extent = centroids[axes[k][count - 1] + face_count * k] - centroids[axes[k][0] + face_count * k];
+
+		if (extent > bestextent)
+		{
+			bestk = k;
+			bestextent = extent;
+		}
+	}
+
+	size_t split = count / 2;
+
+	for (size_t i = 0; i < count; ++i)
+		sides[axes[bestk][i]] = i < split ? 0 : 1;
+
+	// partition other axes into two sides, maintaining order
+	for (int k = 0; k < 3; ++k)
+	{
+		if (k == bestk)
+			continue;
+
+		memcpy(temp, axes[k], sizeof(unsigned int) * count);
+		bvhPartition(axes[k], temp, sides, split, count);
+	}
+
+	// recursion depth is logarithmic since each split halves the triangle count
+	partitionChunks(chunk_offsets, chunk_count, centroids, face_count, orderx, ordery, orderz, offset, split, sides, temp);
+	partitionChunks(chunk_offsets, chunk_count, centroids, face_count, orderx + split, ordery + split, orderz + split, offset + split, count - split, sides, temp);
+}
+
+static unsigned int* hashLookupVertex(unsigned int* table, size_t buckets, const unsigned int* vertices, unsigned int key)
+{
+	assert(buckets > 0);
+	assert((buckets & (buckets - 1)) == 0);
+
+	size_t hashmod = buckets - 1;
+	size_t bucket = (key * 0x5bd1e995) & hashmod;
+
+	for (size_t probe = 0; probe <= hashmod; ++probe)
+	{
+		unsigned int& item = table[bucket];
+
+		if (item == ~0u || vertices[item] == key)
+			return &item;
+
+		// hash collision, quadratic probing
+		bucket = (bucket + probe + 1) & hashmod;
+	}
+
+	assert(false && "Hash table is full"); // unreachable
+	return NULL;
+}
+
+static size_t remapLocalVertices(unsigned int* indices, size_t index_count, unsigned int* local_vertices, float* local_positions, unsigned int* table, size_t table_size, const float* vertex_positions, size_t vertex_count, size_t vertex_stride_float)
+{
+	memset(table, -1, table_size * sizeof(unsigned int));
+
+	size_t local_count = 0;
+
+	for (size_t i = 0; i < index_count; ++i)
+	{
+		unsigned int v = indices[i];
+		assert(v < vertex_count);
+		(void)vertex_count;
+
+		unsigned int* entry = hashLookupVertex(table, table_size, local_vertices, v);
+
+		if (*entry == ~0u)
+		{
+			*entry = unsigned(local_count);
+			local_vertices[local_count] = v;
+			memcpy(&local_positions[local_count * 3], &vertex_positions[v * vertex_stride_float], sizeof(float) * 3);
+			local_count++;
+		}
+
+		indices[i] = *entry;
+	}
+
+	return local_count;
+}
+
+struct MeshletChunkJob
+{
+	const unsigned int* indices;
+	const float* vertex_positions;
+	size_t vertex_count;
+	size_t vertex_stride_float;
+
+	const unsigned int* order;
+	const size_t* chunk_offsets;
+
+	size_t max_vertices;
+	size_t min_triangles;
+	size_t max_triangles;
+	float cone_weight;
+	float split_factor;
+
+	meshopt_Meshlet* chunk_meshlets;
+	const size_t* chunk_meshlet_offsets;
+	size_t* chunk_meshlet_counts;
+
+	unsigned int* meshlet_vertices;
+	unsigned char* meshlet_triangles;
+};
+
+static void buildMeshletChunkTask(void* context, size_t index)
+{
+	const MeshletChunkJob& job = *static_cast<MeshletChunkJob*>(context);
+
+	size_t begin = job.chunk_offsets[index];
+	size_t count = job.chunk_offsets[index + 1] - begin;
+
+	meshopt_Allocator allocator;
+
+	// remap chunk vertices to a compact local range so that the cost of clusterization only depends on the chunk size
+	unsigned int* local_indices = allocator.allocate<unsigned int>(count * 3);
+	unsigned int* local_vertices = allocator.allocate<unsigned int>(count * 3);
+	float* local_positions = allocator.allocate<float>(count * 3 * 3);
+
+	size_t table_size = 1;
+	while (table_size < count * 3 + count * 3 / 4)
+		table_size *= 2;
+
+	unsigned int* table = allocator.allocate<unsigned int>(table_size);
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		unsigned int tri = job.order[begin + i];
+
+		local_indices[i * 3 + 0] = job.indices[tri * 3 + 0];
+		local_indices[i * 3 + 1] = job.indices[tri * 3 + 1];
+		local_indices[i * 3 + 2] = job.indices[tri * 3 + 2];
+	}
+
+	size_t local_count = remapLocalVertices(local_indices, count * 3, local_vertices, local_positions, table, table_size, job.vertex_positions, job.vertex_count, job.vertex_stride_float);
+
+	// each chunk owns the output range that corresponds to its triangles, which is sufficient for the worst case
+	unsigned int* meshlet_vertices = job.meshlet_vertices + begin * 3;
+	unsigned char* meshlet_triangles = job.meshlet_triangles + begin * 3;
+	meshopt_Meshlet* meshlets = job.chunk_meshlets + job.chunk_meshlet_offsets[index];
+
+	size_t meshlet_count = meshopt_buildMeshletsFlex(meshlets, meshlet_vertices, meshlet_triangles, local_indices, count * 3, local_positions, local_count, sizeof(float) * 3, job.max_vertices, job.min_triangles, job.max_triangles, job.cone_weight, job.split_factor);
+	assert(meshlet_count <= job.chunk_meshlet_offsets[index + 1] - job.chunk_meshlet_offsets[index]);
+
+	size_t vertex_total = meshlet_count ? meshlets[meshlet_count - 1].vertex_offset + meshlets[meshlet_count - 1].vertex_count : 0;
+
+	for (size_t i = 0; i < vertex_total; ++i)
+		meshlet_vertices[i] = local_vertices[meshlet_vertices[i]];
+
+	job.chunk_meshlet_counts[index] = meshlet_count;
+}
+
+// Parallel spatial clusterization splits the top levels of the tree with axis-parallel tasks, and then splits each subtree with at most this many triangles in a separate task
+const size_t kMeshletSpatialTaskSize = 16384;
+
+struct SpatialJob
+{
+	const BVHBox* boxes;
+	const float* centroids;
+	const unsigned int* indices;
+	size_t face_count;
+
+	size_t max_vertices;
+	size_t min_triangles;
+	size_t max_triangles;
+	float fill_weight;
+
+	unsigned int* orderx;
+	unsigned int* ordery;
+	unsigned int* orderz;
+	unsigned char* boundary;
+
+	// current node of the top levels; each axis uses its own scratch area
+	unsigned int* axes[3];
+	size_t count;
+	float* scratch[3];
+	size_t step;
+	size_t splits[3];
+	float costs[3];
+	int bestk;
+	size_t bestsplit;
+	const unsigned char* sides;
+
+	// subtrees that are split independently
+	size_t* subtree_offsets;
+	size_t* subtree_counts;
+	int* subtree_depths;
+	size_t subtree_count;
+	unsigned int* triangle_remap;
+};
+
+static void sortAxisTask(void* context, size_t index)
+{
+	const SpatialJob& job = *static_cast<SpatialJob*>(context);
+
+	unsigned int* order = job.orderx + index * job.face_count;
+	bvhSortAxis(order, job.centroids + index * job.face_count, reinterpret_cast<unsigned int*>(job.scratch[index]), job.face_count);
+}
+
+static void pivotAxisTask(void* context, size_t index)
+{
+	SpatialJob& job = *static_cast<SpatialJob*>(context);
+
+	// top level nodes are never vertex bound, so vertex counts (and used[]) are not needed
+	assert(job.count > job.max_triangles);
+
+	job.costs[index] = FLT_MAX;
+	job.splits[index] = bvhPivotAxis(job.scratch[index], job.boxes, job.axes[index], job.count, NULL, job.indices, job.step, job.min_triangles, job.max_triangles, job.fill_weight, job.max_triangles, &job.costs[index]);
+}
+
+static void partitionAxisTask(void* context, size_t index)
+{
+	const SpatialJob& job = *static_cast<SpatialJob*>(context);
+
+	// partition the two axes other than the split axis
+	int k = (job.bestk + 1 + int(index)) % 3;
+
+	unsigned int* temp = reinterpret_cast<unsigned int*>(job.scratch[k]);
+	memcpy(temp, job.axes[k], sizeof(unsigned int) * job.count);
+	bvhPartition(job.axes[k], temp, job.sides, job.bestsplit, job.count);
+}
+
+static void splitSubtreeTask(void* context, size_t index)
+{
+	const SpatialJob& job = *static_cast<SpatialJob*>(context);
+
+	size_t offset = job.subtree_offsets[index];
+	size_t count = job.subtree_counts[index];
+
+	unsigned int* orderx = job.orderx + offset;
+	const unsigned int* ordery = job.ordery + offset;
+	const unsigned int* orderz = job.orderz + offset;
+
+	meshopt_Allocator allocator;
+
+	// subtrees have disjoint triangle sets, so each task can use the shared remap table for its triangles
+	unsigned int* triangles = allocator.allocate<unsigned int>(count);
+	memcpy(triangles, orderx, count * sizeof(unsigned int));
+
+	for (size_t i = 0; i < count; ++i)
+		job.triangle_remap[orderx[i]] = unsigned(i);
+
+	// local copies of subtree data keep the working set small and make used[] private to the task
+	BVHBox* boxes = allocator.allocate<BVHBox>(count + 1); // padding for SIMD
+	unsigned int* indices = allocator.allocate<unsigned int>(count * 3);
+	unsigned int* vertices = allocator.allocate<unsigned int>(count * 3);
+
+	size_t table_size = 1;
+	while (table_size < count * 3 + count * 3 / 4)
+		table_size *= 2;
+
+	unsigned int* table = allocator.allocate<unsigned int>(table_size);
+	memset(table, -1, table_size * sizeof(unsigned int));
+
+	size_t vertex_count = 0;
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		boxes[i] = job.boxes[triangles[i]];
+
+		for (int k = 0; k < 3; ++k)
+		{
+			unsigned int v = job.indices[triangles[i] * 3 + k];
+			unsigned int* entry = hashLookupVertex(table, table_size, vertices, v);
+
+			if (*entry == ~0u)
+			{
+				*entry = unsigned(vertex_count);
+				vertices[vertex_count++] = v;
+			}
+
+			indices[i * 3 + k] = *entry;
+		}
+	}
+
+	memset(boxes + count, 0, sizeof(BVHBox));
+
+	// local triangle order along x is the identity by construction
+	unsigned int* axes = allocator.allocate<unsigned int>(count * 3);
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		axes[i] = unsigned(i);
+		axes[i + count] = job.triangle_remap[ordery[i]];
+		axes[i + count * 2] = job.triangle_remap[orderz[i]];
+	}
+
+	short* used = allocator.allocate<short>(vertex_count);
+	memset(used, -1, vertex_count * sizeof(short));
+
+	float* scratch = allocator.allocate<float>(count * 4);
+
+	bvhSplit(boxes, &axes[0], &axes[count], &axes[count * 2], job.boundary + offset, count, job.subtree_depths[index], scratch, used, indices, job.max_vertices, job.min_triangles, job.max_triangles, job.fill_weight);
+
+	// only the x order is used to pack meshlets after the split
+	for (size_t i = 0; i < count; ++i)
+		orderx[i] = triangles[axes[i]];
+}
+
+static void bvhSplitTop(SpatialJob& job, meshopt_Dispatch dispatch, void* context, unsigned int* orderx, unsigned int* ordery, unsigned int* orderz, size_t count, int depth, unsigned char* sides, short* used)
+{
+	size_t offset = orderx - job.orderx;
+
+	if (count <= kMeshletSpatialTaskSize)
+	{
+		job.subtree_offsets[job.subtree_count] = offset;
+		job.subtree_counts[job.subtree_count] = count;
+		job.subtree_depths[job.subtree_count] = depth;
+		job.subtree_count++;
+		return;
+	}
+
+	// same as bvhSplit for nodes that are larger than max_triangles, with each axis evaluated in a separate task
+	job.axes[0] = orderx;
+	job.axes[1] = ordery;
+	job.axes[2] = orderz;
+	job.count = count;
+	job.step = job.min_triangles == job.max_triangles ? job.max_triangles : 1;
+
+	dispatch(context, pivotAxisTask, &job, 3);
+
+	int bestk = -1;
+	size_t bestsplit = 0;
+	float bestcost = FLT_MAX;
+
+	for (int k = 0; k < 3; ++k)
+		if (job.splits[k] && job.costs[k] < bestcost)
+		{
+			bestk = k;
+			bestcost = job.costs[k];
+			bestsplit = job.splits[k];
+		}
+
+	if (bestk < 0 || depth >= kMeshletMaxTreeDepth)
+		return bvhPackTail(job.boundary + offset, orderx, count, used, job.indices, job.max_vertices, job.max_triangles);
+
+	for (size_t i = 0; i < bestsplit; ++i)
+		sides[job.axes[bestk][i]] = 0;
+
+	for (size_t i = bestsplit; i < count; ++i)
+		sides[job.axes[bestk][i]] = 1;
+
+	job.bestk = bestk;
+	job.bestsplit = bestsplit;
+	job.sides = sides;
+
+	dispatch(context, partitionAxisTask, &job, 2);
+
+	bvhSplitTop(job, dispatch, context, orderx, ordery, orderz, bestsplit, depth + 1, sides, used);
+	bvhSplitTop(job, dispatch, context, orderx + bestsplit, ordery + bestsplit, orderz + bestsplit, count - bestsplit, depth + 1, sides, used);
+}
+
 } // namespace meshopt
 
 size_t meshopt_buildMeshletsBound(size_t index_count, size_t max_vertices, size_t max_triangles)
@@ -1264,6 +1660,11 @@ size_t meshopt_buildMeshletsScan(meshopt_Meshlet* meshlets, unsigned int* meshle
 }
 
 size_t meshopt_buildMeshletsSpatial(struct meshopt_Meshlet* meshlets, unsigned int* meshlet_vertices, unsigned char* meshlet_triangles, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t max_vertices, size_t min_triangles, size_t max_triangles, float fill_weight)
+{
+	return meshopt_buildMeshletsSpatialParallel(meshlets, meshlet_vertices, meshlet_triangles, indices, index_count, vertex_positions, vertex_count, vertex_positions_stride, max_vertices, min_triangles, max_triangles, fill_weight, NULL, NULL);
+}
+
+size_t meshopt_buildMeshletsSpatialParallel(struct meshopt_Meshlet* meshlets, unsigned int* meshlet_vertices, unsigned char* meshlet_triangles, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t max_vertices, size_t min_triangles, size_t max_triangles, float fill_weight, meshopt_Dispatch dispatch, void* context)
 {
 	using namespace meshopt;
 
@@ -1295,24 +1696,6 @@ size_t meshopt_buildMeshletsSpatial(struct meshopt_Meshlet* meshlets, unsigned i
 	memset(boxes + face_count, 0, sizeof(BVHBox));
 
 	unsigned int* axes = allocator.allocate<unsigned int>(face_count * 3);
-	unsigned int* temp = reinterpret_cast<unsigned int*>(scratch) + face_count * 3;
-
-	for (int k = 0; k < 3; ++k)
-	{
-		unsigned int* order = axes + k * face_count;
-		const float* keys = scratch + k * face_count;
-
-		unsigned int hist[1024][3];
-		computeHistogram(hist, keys, face_count);
-
-		// 3-pass radix sort computes the resulting order into axes
-		for (size_t i = 0; i < face_count; ++i)
-			temp[i] = unsigned(i);
-
-		radixPass(order, temp, keys, face_count, hist, 0);
-		radixPass(temp, order, keys, face_count, hist, 1);
-		radixPass(order, temp, keys, face_count, hist, 2);
-	}
 
 	// index of the vertex in the meshlet, -1 if the vertex isn't used
 	short* used = allocator.allocate<short>(vertex_count);
@@ -1320,7 +1703,56 @@ size_t meshopt_buildMeshletsSpatial(struct meshopt_Meshlet* meshlets, unsigned i
 
 	unsigned char* boundary = allocator.allocate<unsigned char>(face_count);
 
-	bvhSplit(boxes, &axes[0], &axes[face_count], &axes[face_count * 2], boundary, face_count, 0, scratch, used, indices, max_vertices, min_triangles, max_triangles, fill_weight);
+	if (!dispatch || face_count <= kMeshletSpatialTaskSize)
+	{
+		bvhSortAxes(axes, scratch, reinterpret_cast<unsigned int*>(scratch) + face_count * 3, face_count);
+
+		bvhSplit(boxes, &axes[0], &axes[face_count], &axes[face_count * 2], boundary, face_count, 0, scratch, used, indices, max_vertices, min_triangles, max_triangles, fill_weight);
+	}
+	else
+	{
+		SpatialJob job = {};
+		job.boxes = boxes;
+		job.centroids = scratch;
+		job.indices = indices;
+		job.face_count = face_count;
+		job.max_vertices = max_vertices;
+		job.min_triangles = min_triangles;
+		job.max_triangles = max_triangles;
+		job.fill_weight = fill_weight;
+		job.orderx = &axes[0];
+		job.ordery = &axes[face_count];
+		job.orderz = &axes[face_count * 2];
+		job.boundary = boundary;
+
+		// each axis needs its own scratch space; sorting needs 1 uint next to the centroids, and pivoting needs 2 floats
+		float* extra = allocator.allocate<float>(face_count * 2);
+
+		job.scratch[0] = scratch + face_count * 3;
+		job.scratch[1] = extra;
+		job.scratch[2] = extra + face_count;
+
+		dispatch(context, sortAxisTask, &job, 3);
+
+		job.scratch[0] = scratch;
+		job.scratch[1] = scratch + face_count * 2;
+		job.scratch[2] = extra;
+
+		// each level of the top tree has at most face_count / kMeshletSpatialTaskSize nodes, and every node has at most two subtree children
+		size_t subtree_capacity = (face_count / kMeshletSpatialTaskSize) * (kMeshletMaxTreeDepth + 1) * 2 + 1;
+
+		job.subtree_offsets = allocator.allocate<size_t>(subtree_capacity);
+		job.subtree_counts = allocator.allocate<size_t>(subtree_capacity);
+		job.subtree_depths = allocator.allocate<int>(subtree_capacity);
+		job.triangle_remap = allocator.allocate<unsigned int>(face_count);
+
+		unsigned char* sides = allocator.allocate<unsigned char>(face_count);
+
+		bvhSplitTop(job, dispatch, context, job.orderx, job.ordery, job.orderz, face_count, 0, sides, used);
+		assert(job.subtree_count <= subtree_capacity);
+
+		dispatch(context, splitSubtreeTask, &job, job.subtree_count);
+	}
 
 	// compute the desired number of meshlets; note that on some meshes with a lot of vertex bound clusters this might go over the bound
 	size_t meshlet_count = 0;
@@ -1364,5 +1796,223 @@ size_t meshopt_buildMeshletsSpatial(struct meshopt_Meshlet* meshlets, unsigned i
 	return meshlet_offset;
 }
 
+size_t meshopt_buildMeshletsParallel(meshopt_Meshlet* meshlets, unsigned int* meshlet_vertices, unsigned char* meshlet_triangles, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t max_vertices, size_t min_triangles, size_t max_triangles, float cone_weight, float split_factor, meshopt_Dispatch dispatch, void* context)
+{
+	using namespace meshopt;
+
+	assert(index_count % 3 == 0);
+	assert(vertex_positions_stride >= 12 && vertex_positions_stride <= 256);
+	assert(vertex_positions_stride % sizeof(float) == 0);
+
+	assert(max_vertices >= 3 && max_vertices <= 256);
+	assert(min_triangles >= 1 && min_triangles <= max_triangles && max_triangles <= 512);
+
+	assert(cone_weight >= 0 && cone_weight <= 1);
+	assert(split_factor >= 0);
+
+	size_t face_count = index_count / 3;
+	size_t vertex_stride_float = vertex_positions_stride / sizeof(float);
+
+	// small meshes are processed as a single chunk which produces the same result as meshopt_buildMeshletsFlex
+	if (face_count <= kMeshletChunkSize)
+		return meshopt_buildMeshletsFlex(meshlets, meshlet_vertices, meshlet_triangles, indices, index_count, vertex_positions, vertex_count, vertex_positions_stride, max_vertices, min_triangles, max_triangles, cone_weight, split_factor);
+
+	meshopt_Allocator allocator;
+
+	// compute triangle centroids and sort them along each axis
+	float* centroids = allocator.allocate<float>(face_count * 3);
+
+	for (size_t i = 0; i < face_count; ++i)
+	{
+		unsigned int a = indices[i * 3 + 0], b = indices[i * 3 + 1], c = indices[i * 3 + 2];
+		assert(a < vertex_count && b < vertex_count && c < vertex_count);
+
+		const float* va = vertex_positions + vertex_stride_float * a;
+		const float* vb = vertex_positions + vertex_stride_float * b;
+		const float* vc = vertex_positions + vertex_stride_float * c;
+
+		for (int k = 0; k < 3; ++k)
+			centroids[i + face_count * k] = (va[k] + vb[k] + vc[k]) / 3.f;
+	}
+
+	unsigned int* axes = allocator.allocate<unsigned int>(face_count * 3);
+	unsigned int* temp = allocator.allocate<unsigned int>(face_count);
+	bvhSortAxes(axes, centroids, temp, face_count);
+
+	// split the mesh into chunks using median splits of the sorted orders
+	size_t chunk_capacity = face_count / (kMeshletChunkSize / 2) + 1;
+	size_t* chunk_offsets = allocator.allocate<size_t>(chunk_capacity + 1);
+	size_t chunk_count = 0;
+
+	unsigned char* sides = allocator.allocate<unsigned char>(face_count);
+	partitionChunks(chunk_offsets, chunk_count, centroids, face_count, &axes[0], &axes[face_count], &axes[face_count * 2], 0, face_count, sides, temp);
+
+	assert(chunk_count <= chunk_capacity);
+	chunk_offsets[chunk_count] = face_count;
+
+	// reserve worst case meshlet storage for each chunk
+	size_t* chunk_meshlet_offsets = allocator.allocate<size_t>(chunk_count + 1);
+	size_t chunk_meshlet_total = 0;
+
+	for (size_t i = 0; i < chunk_count; ++i)
+	{
+		chunk_meshlet_offsets[i] = chunk_meshlet_total;
+		chunk_meshlet_total += meshopt_buildMeshletsBound((chunk_offsets[i + 1] - chunk_offsets[i]) * 3, max_vertices, min_triangles);
+	}
+
+	chunk_meshlet_offsets[chunk_count] = chunk_meshlet_total;
+
+	meshopt_Meshlet* chunk_meshlets = allocator.allocate<meshopt_Meshlet>(chunk_meshlet_total);
+	size_t* chunk_meshlet_counts = allocator.allocate<size_t>(chunk_count);
+
+	MeshletChunkJob job = {};
+	job.indices = indices;
+	job.vertex_positions = vertex_positions;
+	job.vertex_count = vertex_count;
+	job.vertex_stride_float = vertex_stride_float;
+	job.order = axes;
+	job.chunk_offsets = chunk_offsets;
+	job.max_vertices = max_vertices;
+	job.min_triangles = min_triangles;
+	job.max_triangles = max_triangles;
+	job.cone_weight = cone_weight;
+	job.split_factor = split_factor;
+	job.chunk_meshlets = chunk_meshlets;
+	job.chunk_meshlet_offsets = chunk_meshlet_offsets;
+	job.chunk_meshlet_counts = chunk_meshlet_counts;
+	job.meshlet_vertices = meshlet_vertices;
+	job.meshlet_triangles = meshlet_triangles;
+
+	if (dispatch)
+		dispatch(context, buildMeshletChunkTask, &job, chunk_count);
+	else
+		for (size_t i = 0; i < chunk_count; ++i)
+			buildMeshletChunkTask(&job, i);
+
+	// concatenate chunk outputs; data only moves towards the beginning of the output arrays as each chunk uses at most its reserved range
+	size_t meshlet_offset = 0;
+	size_t vertex_offset = 0;
+	size_t triangle_offset = 0;
+
+	for (size_t i = 0; i < chunk_count; ++i)
+	{
+		size_t base = chunk_offsets[i] * 3;
+
+		for (size_t j = 0; j < chunk_meshlet_counts[i]; ++j)
+		{
+			meshopt_Meshlet meshlet = chunk_meshlets[chunk_meshlet_offsets[i] + j];
+
+			assert(vertex_offset <= base + meshlet.vertex_offset && triangle_offset <= base + meshlet.triangle_offset);
+			memmove(&meshlet_vertices[vertex_offset], &meshlet_vertices[base + meshlet.vertex_offset], meshlet.vertex_count * sizeof(unsigned int));
+			memmove(&meshlet_triangles[triangle_offset], &meshlet_triangles[base + meshlet.triangle_offset], meshlet.triangle_count * 3);
+
+			meshlet.vertex_offset = unsigned(vertex_offset);
+			meshlet.triangle_offset = unsigned(triangle_offset);
+
+			vertex_offset += meshlet.vertex_count;
+			triangle_offset += meshlet.triangle_count * 3;
+
+			meshlets[meshlet_offset++] = meshlet;
+		}
+	}
+
+	assert(meshlet_offset <= meshopt_buildMeshletsBound(index_count, max_vertices, min_triangles) + chunk_count);
+	assert(vertex_offset <= index_count && triangle_offset <= index_count);
+	return meshlet_offset;
+}
+
+size_t meshopt_buildMeshletsStream(const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t max_vertices, size_t min_triangles, size_t max_triangles, float cone_weight, float split_factor, size_t window_size, void (*callback)(void* context, const meshopt_Meshlet* meshlet, const unsigned int* meshlet_vertices, const unsigned char* meshlet_triangles), void* context)
+{
+	using namespace meshopt;
+
+	assert(index_count % 3 == 0);
+	assert(vertex_positions_stride >= 12 && vertex_positions_stride <= 256);
+	assert(vertex_positions_stride % sizeof(float) == 0);
+
+	assert(max_vertices >= 3 && max_vertices <= 256);
+	assert(min_triangles >= 1 && min_triangles <= max_triangles && max_triangles <= 512);
+
+	assert(cone_weight >= 0 && cone_weight <= 1);
+	assert(split_factor >= 0);
+
+	assert(window_size > 0);
+	assert(callback);
+
+	size_t face_count = index_count / 3;
+	size_t vertex_stride_float = vertex_positions_stride / sizeof(float);
+
+	meshopt_Allocator allocator;
+
+	// each window contains the next window_size triangles plus the triangles of the last meshlet of the previous window
+	size_t capacity = (window_size < face_count ? window_size : face_count) + max_triangles;
+
+	unsigned int* window = allocator.allocate<unsigned int>(capacity * 3);
+	unsigned int* local_vertices = allocator.allocate<unsigned int>(capacity * 3);
+	float* local_positions = allocator.allocate<float>(capacity * 3 * 3);
+
+	size_t table_size = 1;
+	while (table_size < capacity * 3 + capacity * 3 / 4)
+		table_size *= 2;
+
+	unsigned int* table = allocator.allocate<unsigned int>(table_size);
+
+	meshopt_Meshlet* meshlets = allocator.allocate<meshopt_Meshlet>(meshopt_buildMeshletsBound(capacity * 3, max_vertices, min_triangles));
+	unsigned int* meshlet_vertices = allocator.allocate<unsigned int>(capacity * 3);
+	unsigned char* meshlet_triangles = allocator.allocate<unsigned char>(capacity * 3);
+
+	size_t carried = 0;
+	size_t offset = 0;
+	size_t result = 0;
+
+	while (offset < face_count)
+	{
+		size_t count = face_count - offset < window_size ? face_count - offset : window_size;
+
+		memcpy(window + carried * 3, indices + offset * 3, count * 3 * sizeof(unsigned int));
+		offset += count;
+		count += carried;
+
+		size_t local_count = remapLocalVertices(window, count * 3, local_vertices, local_positions, table, table_size, vertex_positions, vertex_count, vertex_stride_float);
+
+		size_t meshlet_count = meshopt_buildMeshletsFlex(meshlets, meshlet_vertices, meshlet_triangles, window, count * 3, local_positions, local_count, sizeof(float) * 3, max_vertices, min_triangles, max_triangles, cone_weight, split_factor);
+		assert(meshlet_count > 0);
+
+		// the last meshlet of the window is usually underfilled, so unless this is the final window its triangles are clusterized again with the next window
+		size_t emit_count = offset == face_count ? meshlet_count : meshlet_count - 1;
+
+		for (size_t i = 0; i < emit_count; ++i)
+		{
+			meshopt_Meshlet meshlet = meshlets[i];
+			unsigned int* vertices = meshlet_vertices + meshlet.vertex_offset;
+
+			for (size_t j = 0; j < meshlet.vertex_count; ++j)
+				vertices[j] = local_vertices[vertices[j]];
+
+			const unsigned char* triangles = meshlet_triangles + meshlet.triangle_offset;
+
+			meshlet.vertex_offset = 0;
+			meshlet.triangle_offset = 0;
+
+			callback(context, &meshlet, vertices, triangles);
+		}
+
+		result += emit_count;
+		carried = 0;
+
+		if (emit_count < meshlet_count)
+		{
+			const meshopt_Meshlet& meshlet = meshlets[meshlet_count - 1];
+			assert(meshlet.triangle_count <= max_triangles);
+
+			for (size_t j = 0; j < meshlet.triangle_count * 3; ++j)
+				window[j] = local_vertices[meshlet_vertices[meshlet.vertex_offset + meshlet_triangles[meshlet.triangle_offset + j]]];
+
+			carried = meshlet.triangle_count;
+		}
+	}
+
+	return result;
+}
+
 #undef SIMD_SSE
 #undef SIMD_NEON
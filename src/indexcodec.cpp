@@ -138,35 +138,300 @@ static int getCodeAuxIndex(unsigned char v, const unsigned char* table)
 	return -1;
 }
 
-static void* writeTriangle(void* destination, size_t index_size, unsigned int a, unsigned int b, unsigned int c)
+// each seek table entry stores the data offset, next/last indices, fifo offsets and fifo contents at the start of the segment
+const size_t kSeekHeaderSize = 4;
+const size_t kSeekEntrySize = 16 + 16 * 2 * 4 + 16 * 4;
+
+static void writeSeekValue(unsigned char* data, unsigned int v)
 {
-	if (index_size == 2)
-	{
-		unsigned short* tri = static_cast<unsigned short*>(destination);
-		tri[0] = (unsigned short)(a);
-		tri[1] = (unsigned short)(b);
-		tri[2] = (unsigned short)(c);
+	data[0] = (unsigned char)(v >> 0);
+	data[1] = (unsigned char)(v >> 8);
+	data[2] = (unsigned char)(v >> 16);
+	data[3] = (unsigned char)(v >> 24);
+}
+
+static unsigned int readSeekValue(const unsigned char* data)
+{
+	return data[0] | (data[1] << 8) | (data[2] << 16) | (unsigned(data[3]) << 24);
+}
 
-		return tri + 3;
+static void writeSeekEntry(unsigned char* entry, size_t offset, unsigned int next, unsigned int last, size_t edgefifooffset, size_t vertexfifooffset, const EdgeFifo edgefifo, const VertexFifo vertexfifo)
+{
+	writeSeekValue(entry + 0, unsigned(offset));
+	writeSeekValue(entry + 4, next);
+	writeSeekValue(entry + 8, last);
+	writeSeekValue(entry + 12, unsigned(edgefifooffset | (vertexfifooffset << 8)));
+
+	for (int i = 0; i < 16; ++i)
+	{
+		writeSeekValue(entry + 16 + i * 8 + 0, edgefifo[i][0]);
+		writeSeekValue(entry + 16 + i * 8 + 4, edgefifo[i][1]);
 	}
-	else
+
+	for (int i = 0; i < 16; ++i)
+		writeSeekValue(entry + 16 + 16 * 8 + i * 4, vertexfifo[i]);
+}
+
+template <typename T>
+static T* writeTriangle(T* tri, unsigned int a, unsigned int b, unsigned int c)
+{
+	tri[0] = T(a);
+	tri[1] = T(b);
+	tri[2] = T(c);
+
+	return tri + 3;
+}
+
+// decoding loop is specialized for each index type; this removes the index size check from the inner loop
+template <typename T>
+static const unsigned char* decodeTriangles(T* destination, const unsigned char* code, const unsigned char* code_end, const unsigned char* data, const unsigned char* data_safe_end, const unsigned char* codeaux_table, EdgeFifo edgefifo, VertexFifo vertexfifo, size_t edgefifooffset, size_t vertexfifooffset, unsigned int next, unsigned int last, int fecmax)
+{
+	while (code < code_end)
 	{
-		unsigned int* tri = static_cast<unsigned int*>(destination);
-		tri[0] = a;
-		tri[1] = b;
-		tri[2] = c;
+		unsigned char codetri = *code++;
+
+		if (codetri < 0xf0)
+		{
+			int fe = codetri >> 4;
+
+			// fifo reads are wrapped around 16 entry buffer
+			unsigned int a = edgefifo[(edgefifooffset - 1 - fe) & 15][0];
+			unsigned int b = edgefifo[(edgefifooffset - 1 - fe) & 15][1];
+			unsigned int c = 0;
+
+			int fec = codetri & 15;
 
-		return tri + 3;
+			// note: this is the most common path in the entire decoder
+			// inside this if we try to stay branchless (by using cmov/etc.) since these aren't predictable
+			if (fec < fecmax)
+			{
+				// fifo reads are wrapped around 16 entry buffer
+				unsigned int cf = vertexfifo[(vertexfifooffset - 1 - fec) & 15];
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__aarch64__))
+				// on clang, x86-cmov-conversion pass emits a branch since cf is a load from memory; asm barrier defeats this
+				// this can be fixed with __builtin_unpredictable, but gcc doesn't support it and has a similar problem due to if-conversion
+				// additionally, gcc can fuse a/b into one 64-bit load but use 32-bit edgefifo[] stores, which breaks load store forwarding
+				__asm__("" : "+r"(a) : "r"(cf));
+#endif
+
+				c = (fec == 0) ? next : cf;
+
+				int fec0 = fec == 0;
+				next += fec0;
+
+				// push vertex fifo must match the encoding step *exactly* otherwise the data will not be decoded correctly
+				pushVertexFifo(vertexfifo, c, vertexfifooffset, fec0);
+			}
+			else
+			{
+				// make sure we have enough data to read for a triangle; this check covers worst case advance
+				if (data > data_safe_end)
+					return NULL;
+
+				// fec * 2 - 27 decodes 13, 14 into -1, 1
+				// note that we need to update the last index since free indices are delta-encoded
+				last = c = (fec != 15) ? last + (fec * 2 - 27) : decodeIndex(data, last);
+
+				// push vertex/edge fifo must match the encoding step *exactly* otherwise the data will not be decoded correctly
+				pushVertexFifo(vertexfifo, c, vertexfifooffset);
+			}
+
+			// push edge fifo must match the encoding step *exactly* otherwise the data will not be decoded correctly
+			pushEdgeFifo(edgefifo, c, b, edgefifooffset);
+			pushEdgeFifo(edgefifo, a, c, edgefifooffset);
+
+			// output triangle
+			destination = writeTriangle(destination, a, b, c);
+		}
+		else
+		{
+			// fast path: read codeaux from the table
+			if (codetri < 0xfe)
+			{
+				unsigned char codeaux = codeaux_table[codetri & 15];
+
+				// note: table can't contain feb/fec=15
+				int feb = codeaux >> 4;
+				int fec = codeaux & 15;
+
+				// fifo reads are wrapped around 16 entry buffer
+				// also note that we increment next for all three vertices before decoding indices - this matches encoder behavior
+				unsigned int a = next++;
+
+				unsigned int bf = vertexfifo[(vertexfifooffset - feb) & 15];
+				unsigned int b = (feb == 0) ? next : bf;
+
+				int feb0 = feb == 0;
+				next += feb0;
+
+				unsigned int cf = vertexfifo[(vertexfifooffset - fec) & 15];
+				unsigned int c = (fec == 0) ? next : cf;
+
+				int fec0 = fec == 0;
+				next += fec0;
+
+				// output triangle
+				destination = writeTriangle(destination, a, b, c);
+
+				// push vertex/edge fifo must match the encoding step *exactly* otherwise the data will not be decoded correctly
+				pushVertexFifo(vertexfifo, a, vertexfifooffset);
+				pushVertexFifo(vertexfifo, b, vertexfifooffset, feb0);
+				pushVertexFifo(vertexfifo, c, vertexfifooffset, fec0);
+
+				pushEdgeFifo(edgefifo, b, a, edgefifooffset);
+				pushEdgeFifo(edgefifo, c, b, edgefifooffset);
+				pushEdgeFifo(edgefifo, a, c, edgefifooffset);
+			}
+			else
+			{
+				// make sure we have enough data to read for a triangle; this check covers worst case advance
+				if (data > data_safe_end)
+					return NULL;
+
+				// slow path: read a full byte for codeaux instead of using a table lookup
+				unsigned char codeaux = *data++;
+
+				int fea = codetri == 0xfe ? 0 : 15;
+				int feb = codeaux >> 4;
+				int fec = codeaux & 15;
+
+				// reset: codeaux is 0 but encoded as not-a-table
+				if (codeaux == 0)
+					next = 0;
+
+				// fifo reads are wrapped around 16 entry buffer
+				// also note that we increment next for all three vertices before decoding indices - this matches encoder behavior
+				unsigned int a = (fea == 0) ? next++ : 0;
+				unsigned int b = (feb == 0) ? next++ : vertexfifo[(vertexfifooffset - feb) & 15];
+				unsigned int c = (fec == 0) ? next++ : vertexfifo[(vertexfifooffset - fec) & 15];
+
+				// note that we need to update the last index since free indices are delta-encoded
+				if (fea == 15)
+					last = a = decodeIndex(data, last);
+
+				if (feb == 15)
+					last = b = decodeIndex(data, last);
+
+				if (fec == 15)
+					last = c = decodeIndex(data, last);
+
+				// output triangle
+				destination = writeTriangle(destination, a, b, c);
+
+				// push vertex/edge fifo must match the encoding step *exactly* otherwise the data will not be decoded correctly
+				pushVertexFifo(vertexfifo, a, vertexfifooffset);
+				pushVertexFifo(vertexfifo, b, vertexfifooffset, (feb == 0) | (feb == 15));
+				pushVertexFifo(vertexfifo, c, vertexfifooffset, (fec == 0) | (fec == 15));
+
+				pushEdgeFifo(edgefifo, b, a, edgefifooffset);
+				pushEdgeFifo(edgefifo, c, b, edgefifooffset);
+				pushEdgeFifo(edgefifo, a, c, edgefifooffset);
+			}
+		}
 	}
+
+	return data;
+}
+
+struct IndexDecodeJob
+{
+	void* destination;
+	size_t index_count;
+	size_t index_size;
+
+	const unsigned char* buffer;
+	size_t buffer_size;
+	int fecmax;
+
+	const unsigned char* seek;
+	size_t seek_interval;
+
+	int* results;
+};
+
+static int decodeSegment(const IndexDecodeJob& job, size_t segment)
+{
+	const unsigned char* buffer = job.buffer;
+	const unsigned char* entry = job.seek + kSeekHeaderSize + segment * kSeekEntrySize;
+
+	size_t triangle_count = job.index_count / 3;
+	size_t triangle_begin = segment * job.seek_interval;
+	size_t triangle_end = triangle_count - triangle_begin > job.seek_interval ? triangle_begin + job.seek_interval : triangle_count;
+
+	const unsigned char* code = buffer + 1;
+	const unsigned char* code_end = code + triangle_count;
+
+	// each triangle reads at most 16 bytes of data: 1b for codeaux and 5b for each free index
+	const unsigned char* data_safe_end = buffer + job.buffer_size - 16;
+	const unsigned char* codeaux_table = data_safe_end;
+
+	// seek table is untrusted, so we need to validate data offsets before using them
+	size_t offset = readSeekValue(entry + 0);
+	if (offset < size_t(code_end - buffer) || offset > size_t(data_safe_end - buffer))
+		return -2;
+
+	unsigned int next = readSeekValue(entry + 4);
+	unsigned int last = readSeekValue(entry + 8);
+	unsigned int fifooffsets = readSeekValue(entry + 12);
+
+	EdgeFifo edgefifo;
+	for (int i = 0; i < 16; ++i)
+	{
+		edgefifo[i][0] = readSeekValue(entry + 16 + i * 8 + 0);
+		edgefifo[i][1] = readSeekValue(entry + 16 + i * 8 + 4);
+	}
+
+	VertexFifo vertexfifo;
+	for (int i = 0; i < 16; ++i)
+		vertexfifo[i] = readSeekValue(entry + 16 + 16 * 8 + i * 4);
+
+	void* destination = static_cast<char*>(job.destination) + triangle_begin * 3 * job.index_size;
+
+	size_t edgefifooffset = fifooffsets & 15;
+	size_t vertexfifooffset = (fifooffsets >> 8) & 15;
+
+	const unsigned char* data =
+	    job.index_size == 2
+	        ? decodeTriangles(static_cast<unsigned short*>(destination), code + triangle_begin, code + triangle_end, buffer + offset, data_safe_end, codeaux_table, edgefifo, vertexfifo, edgefifooffset, vertexfifooffset, next, last, job.fecmax)
+	        : decodeTriangles(static_cast<unsigned int*>(destination), code + triangle_begin, code + triangle_end, buffer + offset, data_safe_end, codeaux_table, edgefifo, vertexfifo, edgefifooffset, vertexfifooffset, next, last, job.fecmax);
+	if (!data)
+		return -2;
+
+	// each segment must end where the next one begins, and the last segment must end at the codeaux table
+	const unsigned char* data_end = triangle_end == triangle_count ? data_safe_end : buffer + readSeekValue(entry + kSeekEntrySize);
+	if (data != data_end)
+		return -3;
+
+	return 0;
+}
+
+static void decodeSegmentTask(void* context, size_t index)
+{
+	const IndexDecodeJob& job = *static_cast<IndexDecodeJob*>(context);
+
+	job.results[index] = decodeSegment(job, index);
 }
 
 } // namespace meshopt
 
 size_t meshopt_encodeIndexBuffer(unsigned char* buffer, size_t buffer_size, const unsigned int* indices, size_t index_count)
+{
+	return meshopt_encodeIndexBufferSeekable(buffer, buffer_size, NULL, 0, indices, index_count, 0);
+}
+
+size_t meshopt_encodeIndexBufferSeekable(unsigned char* buffer, size_t buffer_size, unsigned char* seek, size_t seek_size, const unsigned int* indices, size_t index_count, size_t seek_interval)
 {
 	using namespace meshopt;
 
 	assert(index_count % 3 == 0);
+	assert(!seek || (seek_interval > 0 && seek_interval <= size_t(~0u)));
+
+	if (seek && seek_size < meshopt_encodeIndexSeekSize(index_count, seek_interval))
+		return 0;
+
+	if (seek)
+		writeSeekValue(seek, unsigned(seek_interval));
 
 	// the minimum valid encoding is header, 1 byte per triangle and a 16-byte codeaux table
 	if (buffer_size < 1 + index_count / 3 + 16)
@@ -208,6 +473,15 @@ size_t meshopt_encodeIndexBuffer(unsigned char* buffer, size_t buffer_size, cons
 		if (data > data_safe_end)
 			return 0;
 
+		// seek entries capture the full decoder state, which allows decoding to start from this triangle
+		if (seek && (i / 3) % seek_interval == 0)
+		{
+			if (size_t(data - buffer) > size_t(~0u))
+				return 0;
+
+			writeSeekEntry(seek + kSeekHeaderSize + (i / 3 / seek_interval) * kSeekEntrySize, data - buffer, next, last, edgefifooffset, vertexfifooffset, edgefifo, vertexfifo);
+		}
+
 		int fer = getEdgeFifo(edgefifo, indices[i + 0], indices[i + 1], indices[i + 2], edgefifooffset);
 
 		if (fer >= 0 && (fer >> 2) < 15)
@@ -357,6 +631,18 @@ size_t meshopt_encodeIndexBufferBound(size_t index_count, size_t vertex_count)
 	return 1 + (index_count / 3) * (2 + 3 * vertex_groups) + 16;
 }
 
+size_t meshopt_encodeIndexSeekSize(size_t index_count, size_t seek_interval)
+{
+	using namespace meshopt;
+
+	assert(index_count % 3 == 0);
+	assert(seek_interval > 0);
+
+	size_t seek_count = (index_count / 3 + seek_interval - 1) / seek_interval;
+
+	return kSeekHeaderSize + seek_count * kSeekEntrySize;
+}
+
 void meshopt_encodeIndexVersion(int version)
 {
 	assert(unsigned(version) <= unsigned(meshopt::kDecodeIndexVersion));
@@ -423,154 +709,71 @@ int meshopt_decodeIndexBuffer(void* destination, size_t index_count, size_t inde
 
 	const unsigned char* codeaux_table = data_safe_end;
 
-	while (code < code_end)
-	{
-		unsigned char codetri = *code++;
-
-		if (codetri < 0xf0)
-		{
-			int fe = codetri >> 4;
-
-			// fifo reads are wrapped around 16 entry buffer
-			unsigned int a = edgefifo[(edgefifooffset - 1 - fe) & 15][0];
-			unsigned int b = edgefifo[(edgefifooffset - 1 - fe) & 15][1];
-			unsigned int c = 0;
-
-			int fec = codetri & 15;
-
-			// note: this is the most common path in the entire decoder
-			// inside this if we try to stay branchless (by using cmov/etc.) since these aren't predictable
-			if (fec < fecmax)
-			{
-				// fifo reads are wrapped around 16 entry buffer
-				unsigned int cf = vertexfifo[(vertexfifooffset - 1 - fec) & 15];
-
-#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__aarch64__))
-				// on clang, x86-cmov-conversion pass emits a branch since cf is a load from memory; asm barrier defeats this
-				// this can be fixed with __builtin_unpredictable, but gcc doesn't support it and has a similar problem due to if-conversion
-				// additionally, gcc can fuse a/b into one 64-bit load but use 32-bit edgefifo[] stores, which breaks load store forwarding
-				__asm__("" : "+r"(a) : "r"(cf));
-#endif
-
-				c = (fec == 0) ? next : cf;
-
-				int fec0 = fec == 0;
-				next += fec0;
-
-				// push vertex fifo must match the encoding step *exactly* otherwise the data will not be decoded correctly
-				pushVertexFifo(vertexfifo, c, vertexfifooffset, fec0);
-			}
-			else
-			{
-				// make sure we have enough data to read for a triangle; this check covers worst case advance
-				if (data > data_safe_end)
-					return -2;
-
-				// fec * 2 - 27 decodes 13, 14 into -1, 1
-				// note that we need to update the last index since free indices are delta-encoded
-				last = c = (fec != 15) ? last + (fec * 2 - 27) : decodeIndex(data, last);
-
-				// push vertex/edge fifo must match the encoding step *exactly* otherwise the data will not be decoded correctly
-				pushVertexFifo(vertexfifo, c, vertexfifooffset);
-			}
-
-			// push edge fifo must match the encoding step *exactly* otherwise the data will not be decoded correctly
-			pushEdgeFifo(edgefifo, c, b, edgefifooffset);
-			pushEdgeFifo(edgefifo, a, c, edgefifooffset);
-
-			// output triangle
-			destination = writeTriangle(destination, index_size, a, b, c);
-		}
-		else
-		{
-			// fast path: read codeaux from the table
-			if (codetri < 0xfe)
-			{
-				unsigned char codeaux = codeaux_table[codetri & 15];
-
-				// note: table can't contain feb/fec=15
-				int feb = codeaux >> 4;
-				int fec = codeaux & 15;
-
-				// fifo reads are wrapped around 16 entry buffer
-				// also note that we increment next for all three vertices before decoding indices - this matches encoder behavior
-				unsigned int a = next++;
-
-				unsigned int bf = vertexfifo[(vertexfifooffset - feb) & 15];
-				unsigned int b = (feb == 0) ? next : bf;
-
-				int feb0 = feb == 0;
-				next += feb0;
-
-				unsigned int cf = vertexfifo[(vertexfifooffset - fec) & 15];
-				unsigned int c = (fec == 0) ? next : cf;
+	data = index_size == 2
+	           ? decodeTriangles(static_cast<unsigned short*>(destination), code, code_end, data, data_safe_end, codeaux_table, edgefifo, vertexfifo, edgefifooffset, vertexfifooffset, next, last, fecmax)
+	           : decodeTriangles(static_cast<unsigned int*>(destination), code, code_end, data, data_safe_end, codeaux_table, edgefifo, vertexfifo, edgefifooffset, vertexfifooffset, next, last, fecmax);
+	if (!data)
+		return -2;
 
-				int fec0 = fec == 0;
-				next += fec0;
+	// we should've read all data bytes and stopped at the boundary between data and codeaux table
+	if (data != data_safe_end)
+		return -3;
 
-				// output triangle
-				destination = writeTriangle(destination, index_size, a, b, c);
+	return 0;
+}
 
-				// push vertex/edge fifo must match the encoding step *exactly* otherwise the data will not be decoded correctly
-				pushVertexFifo(vertexfifo, a, vertexfifooffset);
-				pushVertexFifo(vertexfifo, b, vertexfifooffset, feb0);
-				pushVertexFifo(vertexfifo, c, vertexfifooffset, fec0);
+int meshopt_decodeIndexBufferParallel(void* destination, size_t index_count, size_t index_size, const unsigned char* buffer, size_t buffer_size, const unsigned char* seek, size_t seek_size, meshopt_Dispatch dispatch, void* context)
+{
+	using namespace meshopt;
 
-				pushEdgeFifo(edgefifo, b, a, edgefifooffset);
-				pushEdgeFifo(edgefifo, c, b, edgefifooffset);
-				pushEdgeFifo(edgefifo, a, c, edgefifooffset);
-			}
-			else
-			{
-				// make sure we have enough data to read for a triangle; this check covers worst case advance
-				if (data > data_safe_end)
-					return -2;
+	assert(index_count % 3 == 0);
+	assert(index_size == 2 || index_size == 4);
 
-				// slow path: read a full byte for codeaux instead of using a table lookup
-				unsigned char codeaux = *data++;
+	// the minimum valid encoding is header, 1 byte per triangle and a 16-byte codeaux table
+	if (buffer_size < 1 + index_count / 3 + 16)
+		return -2;
 
-				int fea = codetri == 0xfe ? 0 : 15;
-				int feb = codeaux >> 4;
-				int fec = codeaux & 15;
+	if ((buffer[0] & 0xf0) != kIndexHeader)
+		return -1;
 
-				// reset: codeaux is 0 but encoded as not-a-table
-				if (codeaux == 0)
-					next = 0;
+	int version = buffer[0] & 0x0f;
+	if (version > kDecodeIndexVersion)
+		return -1;
 
-				// fifo reads are wrapped around 16 entry buffer
-				// also note that we increment next for all three vertices before decoding indices - this matches encoder behavior
-				unsigned int a = (fea == 0) ? next++ : 0;
-				unsigned int b = (feb == 0) ? next++ : vertexfifo[(vertexfifooffset - feb) & 15];
-				unsigned int c = (fec == 0) ? next++ : vertexfifo[(vertexfifooffset - fec) & 15];
+	if (seek_size < kSeekHeaderSize)
+		return -2;
 
-				// note that we need to update the last index since free indices are delta-encoded
-				if (fea == 15)
-					last = a = decodeIndex(data, last);
+	size_t seek_interval = readSeekValue(seek);
+	if (seek_interval == 0 || seek_size < meshopt_encodeIndexSeekSize(index_count, seek_interval))
+		return -2;
 
-				if (feb == 15)
-					last = b = decodeIndex(data, last);
+	size_t seek_count = (index_count / 3 + seek_interval - 1) / seek_interval;
 
-				if (fec == 15)
-					last = c = decodeIndex(data, last);
+	meshopt_Allocator allocator;
 
-				// output triangle
-				destination = writeTriangle(destination, index_size, a, b, c);
+	IndexDecodeJob job = {};
+	job.destination = destination;
+	job.index_count = index_count;
+	job.index_size = index_size;
+	job.buffer = buffer;
+	job.buffer_size = buffer_size;
+	job.fecmax = version >= 1 ? 13 : 15;
+	job.seek = seek;
+	job.seek_interval = seek_interval;
+	job.results = allocator.allocate<int>(seek_count);
 
-				// push vertex/edge fifo must match the encoding step *exactly* otherwise the data will not be decoded correctly
-				pushVertexFifo(vertexfifo, a, vertexfifooffset);
-				pushVertexFifo(vertexfifo, b, vertexfifooffset, (feb == 0) | (feb == 15));
-				pushVertexFifo(vertexfifo, c, vertexfifooffset, (fec == 0) | (fec == 15));
+	if (seek_count == 0)
+		return buffer_size == 1 + 16 ? 0 : -3;
 
-				pushEdgeFifo(edgefifo, b, a, edgefifooffset);
-				pushEdgeFifo(edgefifo, c, b, edgefifooffset);
-				pushEdgeFifo(edgefifo, a, c, edgefifooffset);
-			}
-		}
-	}
+	if (dispatch)
+		dispatch(context, decodeSegmentTask, &job, seek_count);
+	else
+		for (size_t i = 0; i < seek_count; ++i)
+			decodeSegmentTask(&job, i);
 
-	// we should've read all data bytes and stopped at the boundary between data and codeaux table
-	if (data != data_safe_end)
-		return -3;
+	for (size_t i = 0; i < seek_count; ++i)
+		if (job.results[i] != 0)
+			return job.results[i];
 
 	return 0;
 }
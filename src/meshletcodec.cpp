@@ -25,6 +25,12 @@
 #define SIMD_TARGET __attribute__((target("sse4.1")))
 #endif
 
+// GCC 8+ and clang 6+ support targeting AVX2 from individual functions; we use cpuid to select the wider variant at runtime
+#if defined(SIMD_SSE) && ((defined(__clang__) && __clang_major__ >= 6) || (!defined(__clang__) && defined(__GNUC__) && __GNUC__ >= 8)) && defined(__x86_64__)
+#define SIMD_DISPATCH
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
 // When targeting AArch64, enable NEON SIMD unconditionally; we do not support SIMD decoding for 32-bit ARM
 #if defined(__aarch64__) || (defined(_MSC_VER) && (defined(_M_ARM64) || defined(_M_ARM64EC)) && _MSC_VER >= 1922)
 #define SIMD_NEON
@@ -48,11 +54,15 @@
 #include <smmintrin.h>
 #endif
 
+#ifdef SIMD_DISPATCH
+#include <immintrin.h>
+#endif
+
 #ifdef SIMD_NEON
 #include <arm_neon.h>
 #endif
 
-#if defined(SIMD_SSE) && defined(SIMD_FALLBACK)
+#if defined(SIMD_SSE) && (defined(SIMD_FALLBACK) || defined(SIMD_DISPATCH))
 #ifdef _MSC_VER
 #include <intrin.h> // __cpuid
 #else
@@ -559,6 +569,123 @@ inline __m128i decodeVertexGroup(__m128i last, unsigned char code, const unsigne
 }
 #endif
 
+#if defined(SIMD_DISPATCH)
+// decodes two vertex groups at once; the prefix sum runs within each 128-bit lane, and the first group's total is carried into the second lane
+SIMD_TARGET_AVX2
+inline __m256i decodeVertexGroupPair(__m256i last, unsigned char code0, unsigned char code1, const unsigned char*& data)
+{
+	const unsigned char* data1 = data + kDecodeTableLength[code0];
+
+	__m128i word0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+	__m128i word1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data1));
+	__m128i shuf0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(kDecodeTableVerts[code0]));
+	__m128i shuf1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(kDecodeTableVerts[code1]));
+
+	__m256i word = _mm256_inserti128_si256(_mm256_castsi128_si256(word0), word1, 1);
+	__m256i shuf = _mm256_inserti128_si256(_mm256_castsi128_si256(shuf0), shuf1, 1);
+
+	__m256i v = _mm256_shuffle_epi8(word, shuf);
+
+	// unzigzag+1
+	__m256i xl = _mm256_sub_epi32(_mm256_setzero_si256(), _mm256_and_si256(v, _mm256_set1_epi32(1)));
+	__m256i xr = _mm256_srli_epi32(v, 1);
+	__m256i x = _mm256_add_epi32(_mm256_xor_si256(xl, xr), _mm256_set1_epi32(1));
+
+	// prefix sum
+	x = _mm256_add_epi32(x, _mm256_slli_si256(x, 8));
+	x = _mm256_add_epi32(x, _mm256_slli_si256(x, 4));
+	x = _mm256_add_epi32(x, _mm256_blend_epi32(_mm256_setzero_si256(), _mm256_permutevar8x32_epi32(x, _mm256_set1_epi32(3)), 0xf0));
+	x = _mm256_add_epi32(x, _mm256_permutevar8x32_epi32(last, _mm256_set1_epi32(7)));
+
+	data = data1 + kDecodeTableLength[code1];
+
+	return x;
+}
+
+SIMD_TARGET_AVX2
+static const unsigned char* decodeVertexPairsAvx2(unsigned int* vertices, const unsigned char*& ctrl, const unsigned char* data, const unsigned char* bound, size_t pairs, __m128i& last)
+{
+	__m256i last2 = _mm256_castsi128_si256(_mm_shuffle_epi32(last, 0xff));
+	last2 = _mm256_permute2x128_si256(last2, last2, 0);
+
+	for (size_t i = 0; i < pairs; ++i)
+	{
+		unsigned char code0 = ctrl[0];
+		unsigned char code1 = ctrl[1];
+		ctrl += 2;
+
+		// same checks as two consecutive groups; second group starts at or after the first one
+		if (data > bound || size_t(bound - data) < kDecodeTableLength[code0])
+			return NULL;
+
+		last2 = decodeVertexGroupPair(last2, code0, code1, data);
+
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(&vertices[i * 8]), last2);
+	}
+
+	last = _mm256_extracti128_si256(last2, 1);
+	return data;
+}
+
+SIMD_TARGET_AVX2
+static const unsigned char* decodeVertexPairsAvx2(unsigned short* vertices, const unsigned char*& ctrl, const unsigned char* data, const unsigned char* bound, size_t pairs, __m128i& last)
+{
+	__m256i repack = _mm256_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 4, 5, 8, 9, 12, 13, 0, 0, 0, 0, 0, 0, 0, 0);
+	__m256i last2 = _mm256_castsi128_si256(_mm_shuffle_epi32(last, 0xff));
+	last2 = _mm256_permute2x128_si256(last2, last2, 0);
+
+	for (size_t i = 0; i < pairs; ++i)
+	{
+		unsigned char code0 = ctrl[0];
+		unsigned char code1 = ctrl[1];
+		ctrl += 2;
+
+		// same checks as two consecutive groups; second group starts at or after the first one
+		if (data > bound || size_t(bound - data) < kDecodeTableLength[code0])
+			return NULL;
+
+		last2 = decodeVertexGroupPair(last2, code0, code1, data);
+
+		// truncate to 16 bits in each lane and gather the low halves of both lanes
+		__m256i r = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(last2, repack), 0x08);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(&vertices[i * 8]), _mm256_castsi256_si128(r));
+	}
+
+	last = _mm256_extracti128_si256(last2, 1);
+	return data;
+}
+
+// triangle decoding is serially dependent on the state, so pairs of groups are decoded in sequence and written with a single shuffle+store
+SIMD_TARGET_AVX2
+static const unsigned char* decodeTrianglePairsAvx2(unsigned int* triangles, const unsigned char*& codes, const unsigned char* extra, const unsigned char* bound, size_t pairs, __m128i& state)
+{
+	__m128i repack = _mm_setr_epi8(1, 2, 3, -1, 4, 5, 6, -1, 9, 10, 11, -1, 12, 13, 14, -1);
+
+	for (size_t i = 0; i < pairs; ++i)
+	{
+		unsigned char code0 = codes[0];
+		unsigned char code1 = codes[1];
+		codes += 2;
+
+		if (extra > bound)
+			return NULL;
+
+		__m128i state0 = decodeTriangleGroup(state, code0, extra);
+
+		if (extra > bound)
+			return NULL;
+
+		state = decodeTriangleGroup(state0, code1, extra);
+
+		// triangle data is in bytes 9..14 of each state
+		__m128i r = _mm_shuffle_epi8(_mm_unpackhi_epi64(state0, state), repack);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(&triangles[i * 4]), r);
+	}
+
+	return extra;
+}
+#endif
+
 #if defined(SIMD_NEON)
 SIMD_TARGET
 inline uint8x16_t decodeTriangleGroup(uint8x16_t state, unsigned char code, const unsigned char*& extra)
@@ -610,8 +737,9 @@ typedef int unaligned_int;
 #endif
 
 #if defined(SIMD_SSE) || defined(SIMD_NEON)
-SIMD_TARGET
-static const unsigned char* decodeTrianglesSimd(unsigned int* triangles, const unsigned char* codes, const unsigned char* extra, const unsigned char* bound, size_t triangle_count)
+template <bool Avx2>
+SIMD_TARGET static const unsigned char*
+decodeTrianglesSimd(unsigned int* triangles, const unsigned char* codes, const unsigned char* extra, const unsigned char* bound, size_t triangle_count)
 {
 #if defined(SIMD_SSE)
 	__m128i repack = _mm_setr_epi8(9, 10, 11, -1, 12, 13, 14, -1, 0, 0, 0, 0, 0, 0, 0, 0);
@@ -622,9 +750,22 @@ static const unsigned char* decodeTrianglesSimd(unsigned int* triangles, const u
 #endif
 
 	size_t groups = triangle_count / 2;
+	size_t i = 0;
+
+#if defined(SIMD_DISPATCH)
+	// process pairs of complete groups when compiled for AVX2 (see decodeMeshletAvx2)
+	if (Avx2)
+	{
+		extra = decodeTrianglePairsAvx2(triangles, codes, extra, bound, groups / 2, state);
+		if (!extra)
+			return NULL;
+
+		i = groups & ~size_t(1);
+	}
+#endif
 
 	// process all complete groups
-	for (size_t i = 0; i < groups; ++i)
+	for (; i < groups; ++i)
 	{
 		unsigned char code = *codes++;
 
@@ -745,8 +886,9 @@ static const unsigned char* decodeTrianglesSimd(unsigned char* triangles, const
 	return extra;
 }
 
-SIMD_TARGET
-static const unsigned char* decodeVerticesSimd(unsigned int* vertices, const unsigned char* ctrl, const unsigned char* data, const unsigned char* bound, size_t vertex_count)
+template <bool Avx2>
+SIMD_TARGET static const unsigned char*
+decodeVerticesSimd(unsigned int* vertices, const unsigned char* ctrl, const unsigned char* data, const unsigned char* bound, size_t vertex_count)
 {
 #if defined(SIMD_SSE)
 	__m128i last = _mm_set1_epi32(-1);
@@ -755,9 +897,22 @@ static const unsigned char* decodeVerticesSimd(unsigned int* vertices, const uns
 #endif
 
 	size_t groups = vertex_count / 4;
+	size_t i = 0;
+
+#if defined(SIMD_DISPATCH)
+	// process pairs of complete groups with 256-bit operations when compiled for AVX2 (see decodeMeshletAvx2)
+	if (Avx2)
+	{
+		data = decodeVertexPairsAvx2(vertices, ctrl, data, bound, groups / 2, last);
+		if (!data)
+			return NULL;
+
+		i = groups & ~size_t(1);
+	}
+#endif
 
 	// process all complete groups
-	for (size_t i = 0; i < groups; ++i)
+	for (; i < groups; ++i)
 	{
 		unsigned char code = *ctrl++;
 		if (data > bound)
@@ -802,8 +957,9 @@ static const unsigned char* decodeVerticesSimd(unsigned int* vertices, const uns
 	return data;
 }
 
-SIMD_TARGET
-static const unsigned char* decodeVerticesSimd(unsigned short* vertices, const unsigned char* ctrl, const unsigned char* data, const unsigned char* bound, size_t vertex_count)
+template <bool Avx2>
+SIMD_TARGET static const unsigned char*
+decodeVerticesSimd(unsigned short* vertices, const unsigned char* ctrl, const unsigned char* data, const unsigned char* bound, size_t vertex_count)
 {
 #if defined(SIMD_SSE)
 	__m128i repack = _mm_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, 0, 0, 0, 0, 0, 0, 0, 0);
@@ -815,9 +971,22 @@ static const unsigned char* decodeVerticesSimd(unsigned short* vertices, const u
 	// because the output buffer is guaranteed to have 32-bit aligned size available, we can simplify tail processing
 	// if the number of vertices mod 4 is 3, we'd normally need to write 8+6 bytes, but we can instead overwrite up to 2 bytes in the main loop
 	size_t groups = (vertex_count + 1) / 4;
+	size_t i = 0;
+
+#if defined(SIMD_DISPATCH)
+	// process pairs of complete groups with 256-bit operations when compiled for AVX2 (see decodeMeshletAvx2)
+	if (Avx2)
+	{
+		data = decodeVertexPairsAvx2(vertices, ctrl, data, bound, groups / 2, last);
+		if (!data)
+			return NULL;
+
+		i = groups & ~size_t(1);
+	}
+#endif
 
 	// process all complete groups
-	for (size_t i = 0; i < groups; ++i)
+	for (; i < groups; ++i)
 	{
 		unsigned char code = *ctrl++;
 
@@ -859,7 +1028,7 @@ static const unsigned char* decodeVerticesSimd(unsigned short* vertices, const u
 	return data;
 }
 
-template <int Raw>
+template <int Raw, bool Avx2>
 SIMD_TARGET SIMD_FLATTEN static int
 decodeMeshletSimd(void* vertices, void* triangles, const unsigned char* codes, const unsigned char* ctrl, const unsigned char* data, const unsigned char* bound, size_t vertex_count, size_t triangle_count, size_t vertex_size, size_t triangle_size)
 {
@@ -874,16 +1043,16 @@ decodeMeshletSimd(void* vertices, void* triangles, const unsigned char* codes, c
 	// decodes 4 vertices at a time with tail processing; writes up to align(vertex_size * vertex_count, 4)
 	// raw decoding skips tail processing by rounding up vertex count; it's safe because output buffer is guaranteed to have extra space, and tail control data is 0
 	if (vertex_size == 4 || Raw)
-		data = decodeVerticesSimd(static_cast<unsigned int*>(vertices), ctrl, data, bound, Raw ? (vertex_count + 3) & ~3 : vertex_count);
+		data = decodeVerticesSimd<Avx2>(static_cast<unsigned int*>(vertices), ctrl, data, bound, Raw ? (vertex_count + 3) & ~3 : vertex_count);
 	else
-		data = decodeVerticesSimd(static_cast<unsigned short*>(vertices), ctrl, data, bound, vertex_count);
+		data = decodeVerticesSimd<Avx2>(static_cast<unsigned short*>(vertices), ctrl, data, bound, vertex_count);
 	if (!data)
 		return -2;
 
 	// decodes 2/4 triangles at a time with tail processing; writes up to align(triangle_size * triangle_count, 4)
 	// raw decoding skips tail processing by rounding up triangle count; it's safe because output buffer is guaranteed to have extra space, and tail code data is 0
 	if (triangle_size == 4 || Raw)
-		data = decodeTrianglesSimd(static_cast<unsigned int*>(triangles), codes, data, bound, Raw ? (triangle_count + 1) & ~1 : triangle_count);
+		data = decodeTrianglesSimd<Avx2>(static_cast<unsigned int*>(triangles), codes, data, bound, Raw ? (triangle_count + 1) & ~1 : triangle_count);
 	else
 		data = decodeTrianglesSimd(static_cast<unsigned char*>(triangles), codes, data, bound, triangle_count);
 	if (!data)
@@ -893,6 +1062,138 @@ decodeMeshletSimd(void* vertices, void* triangles, const unsigned char* codes, c
 }
 #endif
 
+static bool getMeshletLayout(const unsigned char* buffer, size_t buffer_size, size_t vertex_count, size_t triangle_count, const unsigned char*& codes, const unsigned char*& ctrl, const unsigned char*& bound)
+{
+	// layout must match encoding
+	size_t codes_size = (triangle_count + 1) / 2;
+	size_t ctrl_size = (vertex_count + 3) / 4;
+	size_t gap_size = (codes_size + ctrl_size < 16) ? 16 - (codes_size + ctrl_size) : 0;
+
+	if (buffer_size < codes_size + ctrl_size + gap_size)
+		return false;
+
+	const unsigned char* end = buffer + buffer_size;
+	codes = end - codes_size;
+	ctrl = codes - ctrl_size;
+
+	// gap ensures we have at least 16 bytes available after bound; this allows SIMD decoders to over-read safely
+	bound = ctrl - gap_size;
+	assert(bound >= buffer && bound + 16 <= buffer + buffer_size);
+
+	return true;
+}
+
+static void* getMeshletBatchOutput(void* output, size_t offset, size_t size)
+{
+	return output ? static_cast<char*>(output) + offset * size : NULL;
+}
+
+#if defined(SIMD_FALLBACK) || (!defined(SIMD_SSE) && !defined(SIMD_NEON))
+static int decodeMeshletBatch(void* vertices, size_t vertex_size, void* triangles, size_t triangle_size, const meshopt_Meshlet* meshlets, size_t meshlet_count, const unsigned char* buffer, const unsigned int* buffer_offsets)
+{
+	for (size_t i = 0; i < meshlet_count; ++i)
+	{
+		const meshopt_Meshlet& meshlet = meshlets[i];
+
+		const unsigned char *codes, *ctrl, *bound;
+		if (!getMeshletLayout(buffer + buffer_offsets[i], buffer_offsets[i + 1] - buffer_offsets[i], meshlet.vertex_count, meshlet.triangle_count, codes, ctrl, bound))
+			return -2;
+
+		void* mv = getMeshletBatchOutput(vertices, meshlet.vertex_offset, vertex_size);
+		void* mt = getMeshletBatchOutput(triangles, meshlet.triangle_offset / 3, triangle_size);
+
+		int rc = decodeMeshlet(mv, mt, codes, ctrl, buffer + buffer_offsets[i], bound, meshlet.vertex_count, meshlet.triangle_count, vertex_size, triangle_size);
+		if (rc != 0)
+			return rc;
+	}
+
+	return 0;
+}
+#endif
+
+#if defined(SIMD_SSE) || defined(SIMD_NEON)
+// the entire loop is compiled with SIMD decoders inlined; this avoids per-meshlet dispatch and keeps decoding tables hot
+template <bool Avx2>
+SIMD_TARGET SIMD_FLATTEN static int
+decodeMeshletBatchSimd(void* vertices, size_t vertex_size, void* triangles, size_t triangle_size, const meshopt_Meshlet* meshlets, size_t meshlet_count, const unsigned char* buffer, const unsigned int* buffer_offsets)
+{
+	for (size_t i = 0; i < meshlet_count; ++i)
+	{
+		const meshopt_Meshlet& meshlet = meshlets[i];
+
+		const unsigned char *codes, *ctrl, *bound;
+		if (!getMeshletLayout(buffer + buffer_offsets[i], buffer_offsets[i + 1] - buffer_offsets[i], meshlet.vertex_count, meshlet.triangle_count, codes, ctrl, bound))
+			return -2;
+
+		void* mv = getMeshletBatchOutput(vertices, meshlet.vertex_offset, vertex_size);
+		void* mt = getMeshletBatchOutput(triangles, meshlet.triangle_offset / 3, triangle_size);
+
+		int rc = decodeMeshletSimd<0, Avx2>(mv, mt, codes, ctrl, buffer + buffer_offsets[i], bound, meshlet.vertex_count, meshlet.triangle_count, vertex_size, triangle_size);
+		if (rc != 0)
+			return rc;
+	}
+
+	return 0;
+}
+#endif
+
+#ifdef SIMD_DISPATCH
+// the decoders are inlined into these wrappers so that the entire meshlet (or batch) is compiled for AVX2
+template <int Raw>
+SIMD_TARGET_AVX2 SIMD_FLATTEN static int
+decodeMeshletAvx2(void* vertices, void* triangles, const unsigned char* codes, const unsigned char* ctrl, const unsigned char* data, const unsigned char* bound, size_t vertex_count, size_t triangle_count, size_t vertex_size, size_t triangle_size)
+{
+	return decodeMeshletSimd<Raw, true>(vertices, triangles, codes, ctrl, data, bound, vertex_count, triangle_count, vertex_size, triangle_size);
+}
+
+SIMD_TARGET_AVX2 SIMD_FLATTEN static int
+decodeMeshletBatchAvx2(void* vertices, size_t vertex_size, void* triangles, size_t triangle_size, const meshopt_Meshlet* meshlets, size_t meshlet_count, const unsigned char* buffer, const unsigned int* buffer_offsets)
+{
+	return decodeMeshletBatchSimd<true>(vertices, vertex_size, triangles, triangle_size, meshlets, meshlet_count, buffer, buffer_offsets);
+}
+#endif
+
+static int getSimdLevel()
+{
+#if defined(SIMD_SSE) || defined(SIMD_NEON)
+	// decoding tables are only built when the CPU supports SSE4.1
+	if (!gDecodeTablesInitialized)
+		return 0;
+#endif
+
+#if defined(SIMD_DISPATCH)
+	int cpuinfo[4] = {};
+	__cpuid(1, cpuinfo[0], cpuinfo[1], cpuinfo[2], cpuinfo[3]);
+
+	// AVX state must be enabled by the OS (OSXSAVE+XCR0), in addition to the CPU supporting the instructions
+	const int osmask = (1 << 27) | (1 << 28); // OSXSAVE+AVX
+	if ((cpuinfo[2] & osmask) != osmask || __get_cpuid_max(0, NULL) < 7)
+		return 1;
+
+	unsigned int xcr0, xcr0h;
+	__asm__("xgetbv" : "=a"(xcr0), "=d"(xcr0h) : "c"(0));
+	(void)xcr0h;
+
+	int cpuinfo7[4] = {};
+	__cpuid_count(7, 0, cpuinfo7[0], cpuinfo7[1], cpuinfo7[2], cpuinfo7[3]);
+
+	const int avx2mask = 1 << 5;                       // AVX2
+	const unsigned int ymmstate = (1 << 1) | (1 << 2); // SSE+AVX state
+
+	if ((cpuinfo7[1] & avx2mask) != avx2mask || (xcr0 & ymmstate) != ymmstate)
+		return 1;
+
+	return 2;
+#elif defined(SIMD_SSE) || defined(SIMD_NEON)
+	return 1;
+#else
+	return 0;
+#endif
+}
+
+static const int kDecodeMeshletSimdLevel = getSimdLevel();
+static int gDecodeMeshletSimdLevel = kDecodeMeshletSimdLevel;
+
 } // namespace meshopt
 
 size_t meshopt_encodeMeshletBound(size_t max_vertices, size_t max_triangles)
@@ -986,27 +1287,20 @@ int meshopt_decodeMeshlet(void* vertices, size_t vertex_count, size_t vertex_siz
 	assert(vertex_size == 4 || vertex_size == 2);
 	assert(triangle_size == 4 || triangle_size == 3);
 
-	// layout must match encoding
-	size_t codes_size = (triangle_count + 1) / 2;
-	size_t ctrl_size = (vertex_count + 3) / 4;
-	size_t gap_size = (codes_size + ctrl_size < 16) ? 16 - (codes_size + ctrl_size) : 0;
-
-	if (buffer_size < codes_size + ctrl_size + gap_size)
+	const unsigned char *codes, *ctrl, *bound;
+	if (!getMeshletLayout(buffer, buffer_size, vertex_count, triangle_count, codes, ctrl, bound))
 		return -2;
 
-	const unsigned char* end = buffer + buffer_size;
-	const unsigned char* codes = end - codes_size;
-	const unsigned char* ctrl = codes - ctrl_size;
 	const unsigned char* data = buffer;
 
-	// gap ensures we have at least 16 bytes available after bound; this allows SIMD decoders to over-read safely
-	const unsigned char* bound = ctrl - gap_size;
-	assert(bound >= buffer && bound + 16 <= buffer + buffer_size);
-
-#if defined(SIMD_FALLBACK)
-	return (gDecodeTablesInitialized ? decodeMeshletSimd<0> : decodeMeshlet)(vertices, triangles, codes, ctrl, data, bound, vertex_count, triangle_count, vertex_size, triangle_size);
+#if defined(SIMD_DISPATCH) && defined(SIMD_FALLBACK)
+	return (gDecodeMeshletSimdLevel >= 2 ? decodeMeshletAvx2<0> : gDecodeMeshletSimdLevel == 1 ? decodeMeshletSimd<0, false> : decodeMeshlet)(vertices, triangles, codes, ctrl, data, bound, vertex_count, triangle_count, vertex_size, triangle_size);
+#elif defined(SIMD_DISPATCH)
+	return (gDecodeMeshletSimdLevel >= 2 ? decodeMeshletAvx2<0> : decodeMeshletSimd<0, false>)(vertices, triangles, codes, ctrl, data, bound, vertex_count, triangle_count, vertex_size, triangle_size);
+#elif defined(SIMD_FALLBACK)
+	return (gDecodeMeshletSimdLevel >= 1 ? decodeMeshletSimd<0, false> : decodeMeshlet)(vertices, triangles, codes, ctrl, data, bound, vertex_count, triangle_count, vertex_size, triangle_size);
 #elif defined(SIMD_SSE) || defined(SIMD_NEON)
-	return decodeMeshletSimd<0>(vertices, triangles, codes, ctrl, data, bound, vertex_count, triangle_count, vertex_size, triangle_size);
+	return decodeMeshletSimd<0, false>(vertices, triangles, codes, ctrl, data, bound, vertex_count, triangle_count, vertex_size, triangle_size);
 #else
 	return decodeMeshlet(vertices, triangles, codes, ctrl, data, bound, vertex_count, triangle_count, vertex_size, triangle_size);
 #endif
@@ -1018,34 +1312,82 @@ int meshopt_decodeMeshletRaw(unsigned int* vertices, size_t vertex_count, unsign
 
 	assert(triangle_count <= 256 && vertex_count <= 256);
 
-	// layout must match encoding
-	size_t codes_size = (triangle_count + 1) / 2;
-	size_t ctrl_size = (vertex_count + 3) / 4;
-	size_t gap_size = (codes_size + ctrl_size < 16) ? 16 - (codes_size + ctrl_size) : 0;
-
-	if (buffer_size < codes_size + ctrl_size + gap_size)
+	const unsigned char *codes, *ctrl, *bound;
+	if (!getMeshletLayout(buffer, buffer_size, vertex_count, triangle_count, codes, ctrl, bound))
 		return -2;
 
-	const unsigned char* end = buffer + buffer_size;
-	const unsigned char* codes = end - codes_size;
-	const unsigned char* ctrl = codes - ctrl_size;
 	const unsigned char* data = buffer;
 
-	// gap ensures we have at least 16 bytes available after bound; this allows SIMD decoders to over-read safely
-	const unsigned char* bound = ctrl - gap_size;
-	assert(bound >= buffer && bound + 16 <= buffer + buffer_size);
-
-#if defined(SIMD_FALLBACK)
-	return (gDecodeTablesInitialized ? decodeMeshletSimd<1> : decodeMeshlet)(vertices, triangles, codes, ctrl, data, bound, vertex_count, triangle_count, 4, 4);
+#if defined(SIMD_DISPATCH) && defined(SIMD_FALLBACK)
+	return (gDecodeMeshletSimdLevel >= 2 ? decodeMeshletAvx2<1> : gDecodeMeshletSimdLevel == 1 ? decodeMeshletSimd<1, false> : decodeMeshlet)(vertices, triangles, codes, ctrl, data, bound, vertex_count, triangle_count, 4, 4);
+#elif defined(SIMD_DISPATCH)
+	return (gDecodeMeshletSimdLevel >= 2 ? decodeMeshletAvx2<1> : decodeMeshletSimd<1, false>)(vertices, triangles, codes, ctrl, data, bound, vertex_count, triangle_count, 4, 4);
+#elif defined(SIMD_FALLBACK)
+	return (gDecodeMeshletSimdLevel >= 1 ? decodeMeshletSimd<1, false> : decodeMeshlet)(vertices, triangles, codes, ctrl, data, bound, vertex_count, triangle_count, 4, 4);
 #elif defined(SIMD_SSE) || defined(SIMD_NEON)
-	return decodeMeshletSimd<1>(vertices, triangles, codes, ctrl, data, bound, vertex_count, triangle_count, 4, 4);
+	return decodeMeshletSimd<1, false>(vertices, triangles, codes, ctrl, data, bound, vertex_count, triangle_count, 4, 4);
 #else
 	return decodeMeshlet(vertices, triangles, codes, ctrl, data, bound, vertex_count, triangle_count, 4, 4);
 #endif
 }
 
+int meshopt_decodeMeshletBatch(void* vertices, size_t vertex_size, void* triangles, size_t triangle_size, const struct meshopt_Meshlet* meshlets, size_t meshlet_count, const unsigned char* buffer, size_t buffer_size, const unsigned int* buffer_offsets)
+{
+	using namespace meshopt;
+
+	assert(vertex_size == 4 || vertex_size == 2);
+	assert(triangle_size == 4 || triangle_size == 3);
+
+	for (size_t i = 0; i < meshlet_count; ++i)
+	{
+		assert(meshlets[i].triangle_count <= 256 && meshlets[i].vertex_count <= 256);
+		assert(vertices || meshlets[i].vertex_count == 0);
+		assert(meshlets[i].triangle_offset % 3 == 0);
+
+		// writes past the end of each meshlet output are only safe if the following outputs are decoded later
+		assert(i == 0 || meshlets[i].vertex_count == 0 || meshlets[i].vertex_offset >= meshlets[i - 1].vertex_offset + meshlets[i - 1].vertex_count);
+		assert(i == 0 || meshlets[i].triangle_count == 0 || meshlets[i].triangle_offset >= meshlets[i - 1].triangle_offset + meshlets[i - 1].triangle_count * 3);
+
+		// encoded spans are validated upfront so that the decoding loop only needs to check the encoded data
+		if (buffer_offsets[i] > buffer_offsets[i + 1] || buffer_offsets[i + 1] > buffer_size)
+			return -2;
+	}
+
+#if defined(SIMD_DISPATCH) && defined(SIMD_FALLBACK)
+	return (gDecodeMeshletSimdLevel >= 2 ? decodeMeshletBatchAvx2 : gDecodeMeshletSimdLevel == 1 ? decodeMeshletBatchSimd<false> : decodeMeshletBatch)(vertices, vertex_size, triangles, triangle_size, meshlets, meshlet_count, buffer, buffer_offsets);
+#elif defined(SIMD_DISPATCH)
+	return (gDecodeMeshletSimdLevel >= 2 ? decodeMeshletBatchAvx2 : decodeMeshletBatchSimd<false>)(vertices, vertex_size, triangles, triangle_size, meshlets, meshlet_count, buffer, buffer_offsets);
+#elif defined(SIMD_FALLBACK)
+	return (gDecodeMeshletSimdLevel >= 1 ? decodeMeshletBatchSimd<false> : decodeMeshletBatch)(vertices, vertex_size, triangles, triangle_size, meshlets, meshlet_count, buffer, buffer_offsets);
+#elif defined(SIMD_SSE) || defined(SIMD_NEON)
+	return decodeMeshletBatchSimd<false>(vertices, vertex_size, triangles, triangle_size, meshlets, meshlet_count, buffer, buffer_offsets);
+#else
+	return decodeMeshletBatch(vertices, vertex_size, triangles, triangle_size, meshlets, meshlet_count, buffer, buffer_offsets);
+#endif
+}
+
+int meshopt_decodeMeshletSimdLevel(int level)
+{
+	using namespace meshopt;
+
+	assert(level >= 0);
+
+	// scalar decoder is only compiled in when SIMD support needs to be detected at runtime
+#if defined(SIMD_FALLBACK) || (!defined(SIMD_SSE) && !defined(SIMD_NEON))
+	int min_level = 0;
+#else
+	int min_level = 1;
+#endif
+
+	gDecodeMeshletSimdLevel = level < min_level ? min_level : (level > kDecodeMeshletSimdLevel ? kDecodeMeshletSimdLevel : level);
+
+	return gDecodeMeshletSimdLevel;
+}
+
 #undef SIMD_SSE
 #undef SIMD_NEON
 #undef SIMD_FALLBACK
+#undef SIMD_DISPATCH
 #undef SIMD_FLATTEN
 #undef SIMD_TARGET
+#undef SIMD_TARGET_AVX2
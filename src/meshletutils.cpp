@@ -6,6 +6,17 @@
 #include <math.h>
 #include <string.h>
 
+// The block below auto-detects SIMD ISA that can be used on the target platform
+#ifndef MESHOPTIMIZER_NO_SIMD
+#if defined(__SSE2__) || (defined(_MSC_VER) && defined(_M_X64) && !defined(_M_ARM64EC))
+#define SIMD_SSE
+#include <emmintrin.h>
+#elif defined(__aarch64__) || (defined(_MSC_VER) && (defined(_M_ARM64) || defined(_M_ARM64EC)) && _MSC_VER >= 1922)
+#define SIMD_NEON
+#include <arm_neon.h>
+#endif
+#endif // !MESHOPTIMIZER_NO_SIMD
+
 // This work is based on:
 // Matthaeus Chajdas. GeometryFX 1.2 - Cluster Culling. 2016
 // Jack Ritter. An Efficient Bounding Sphere. 1990
@@ -19,30 +30,94 @@ const size_t kMeshletMaxVertices = 256;
 // A reasonable limit is around 2*max_vertices or less
 const size_t kMeshletMaxTriangles = 512;
 
-static void computeBoundingSphere(float result[4], const float* points, size_t count, size_t points_stride, const float* radii, size_t radii_stride, size_t axis_count, const unsigned int* indices = NULL)
+// Axes for the extremum search, stored as SoA with padding to a multiple of 4 for SIMD
+static const float kSphereAxes[3][8] = {
+    // X, Y, Z, XYZ, -XYZ, X-YZ, XY-Z (normalized to unit length), padding
+    {1, 0, 0, 0.57735026f, -0.57735026f, 0.57735026f, 0.57735026f, 0},
+    {0, 1, 0, 0.57735026f, 0.57735026f, -0.57735026f, 0.57735026f, 0},
+    {0, 0, 1, 0.57735026f, 0.57735026f, 0.57735026f, -0.57735026f, 0},
+};
+
+#if defined(SIMD_SSE)
+static void computeExtremes(unsigned int pmin[8], unsigned int pmax[8], const float* points, size_t count, size_t points_stride_float, const float* radii, size_t radii_stride_float, size_t axis_count, const unsigned int* indices)
 {
-	static const float axes[7][3] = {
-	    // X, Y, Z
-	    {1, 0, 0},
-	    {0, 1, 0},
-	    {0, 0, 1},
-
-	    // XYZ, -XYZ, X-YZ, XY-Z; normalized to unit length
-	    {0.57735026f, 0.57735026f, 0.57735026f},
-	    {-0.57735026f, 0.57735026f, 0.57735026f},
-	    {0.57735026f, -0.57735026f, 0.57735026f},
-	    {0.57735026f, 0.57735026f, -0.57735026f},
-	};
+	// each group processes 4 axes at a time; padding axes produce extremes that are ignored
+	for (size_t group = 0; group < axis_count; group += 4)
+	{
+		__m128 axx = _mm_loadu_ps(&kSphereAxes[0][group]);
+		__m128 axy = _mm_loadu_ps(&kSphereAxes[1][group]);
+		__m128 axz = _mm_loadu_ps(&kSphereAxes[2][group]);
 
-	assert(count > 0);
-	assert(axis_count <= sizeof(axes) / sizeof(axes[0]));
+		__m128 tmin = _mm_set1_ps(FLT_MAX);
+		__m128 tmax = _mm_set1_ps(-FLT_MAX);
+		__m128i imin = _mm_setzero_si128();
+		__m128i imax = _mm_setzero_si128();
 
-	size_t points_stride_float = points_stride / sizeof(float);
-	size_t radii_stride_float = radii_stride / sizeof(float);
+		for (size_t i = 0; i < count; ++i)
+		{
+			unsigned int v = indices ? indices[i] : unsigned(i);
+			const float* p = points + v * points_stride_float;
+			__m128 r = _mm_set1_ps(radii[v * radii_stride_float]);
 
-	// find extremum points along all axes; for each axis we get a pair of points with min/max coordinates
-	unsigned int pmin[7], pmax[7];
-	float tmin[7], tmax[7];
+			__m128 tp = _mm_add_ps(_mm_add_ps(_mm_mul_ps(axx, _mm_set1_ps(p[0])), _mm_mul_ps(axy, _mm_set1_ps(p[1]))), _mm_mul_ps(axz, _mm_set1_ps(p[2])));
+			__m128 tpmin = _mm_sub_ps(tp, r), tpmax = _mm_add_ps(tp, r);
+
+			__m128i mmin = _mm_castps_si128(_mm_cmplt_ps(tpmin, tmin));
+			__m128i mmax = _mm_castps_si128(_mm_cmpgt_ps(tpmax, tmax));
+			__m128i iv = _mm_set1_epi32(int(v));
+
+			imin = _mm_or_si128(_mm_and_si128(mmin, iv), _mm_andnot_si128(mmin, imin));
+			imax = _mm_or_si128(_mm_and_si128(mmax, iv), _mm_andnot_si128(mmax, imax));
+			tmin = _mm_min_ps(tpmin, tmin);
+			tmax = _mm_max_ps(tpmax, tmax);
+		}
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(&pmin[group]), imin);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(&pmax[group]), imax);
+	}
+}
+#elif defined(SIMD_NEON)
+static void computeExtremes(unsigned int pmin[8], unsigned int pmax[8], const float* points, size_t count, size_t points_stride_float, const float* radii, size_t radii_stride_float, size_t axis_count, const unsigned int* indices)
+{
+	// each group processes 4 axes at a time; padding axes produce extremes that are ignored
+	for (size_t group = 0; group < axis_count; group += 4)
+	{
+		float32x4_t axx = vld1q_f32(&kSphereAxes[0][group]);
+		float32x4_t axy = vld1q_f32(&kSphereAxes[1][group]);
+		float32x4_t axz = vld1q_f32(&kSphereAxes[2][group]);
+
+		float32x4_t tmin = vdupq_n_f32(FLT_MAX);
+		float32x4_t tmax = vdupq_n_f32(-FLT_MAX);
+		uint32x4_t imin = vdupq_n_u32(0);
+		uint32x4_t imax = vdupq_n_u32(0);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			unsigned int v = indices ? indices[i] : unsigned(i);
+			const float* p = points + v * points_stride_float;
+			float32x4_t r = vdupq_n_f32(radii[v * radii_stride_float]);
+
+			float32x4_t tp = vaddq_f32(vaddq_f32(vmulq_f32(axx, vdupq_n_f32(p[0])), vmulq_f32(axy, vdupq_n_f32(p[1]))), vmulq_f32(axz, vdupq_n_f32(p[2])));
+			float32x4_t tpmin = vsubq_f32(tp, r), tpmax = vaddq_f32(tp, r);
+
+			uint32x4_t mmin = vcltq_f32(tpmin, tmin);
+			uint32x4_t mmax = vcgtq_f32(tpmax, tmax);
+			uint32x4_t iv = vdupq_n_u32(v);
+
+			imin = vbslq_u32(mmin, iv, imin);
+			imax = vbslq_u32(mmax, iv, imax);
+			tmin = vbslq_f32(mmin, tpmin, tmin);
+			tmax = vbslq_f32(mmax, tpmax, tmax);
+		}
+
+		vst1q_u32(&pmin[group], imin);
+		vst1q_u32(&pmax[group], imax);
+	}
+}
+#else
+static void computeExtremes(unsigned int pmin[8], unsigned int pmax[8], const float* points, size_t count, size_t points_stride_float, const float* radii, size_t radii_stride_float, size_t axis_count, const unsigned int* indices)
+{
+	float tmin[8], tmax[8];
 
 	for (size_t axis = 0; axis < axis_count; ++axis)
 	{
@@ -59,9 +134,7 @@ static void computeBoundingSphere(float result[4], const float* points, size_t c
 
 		for (size_t axis = 0; axis < axis_count; ++axis)
 		{
-			const float* ax = axes[axis];
-
-			float tp = ax[0] * p[0] + ax[1] * p[1] + ax[2] * p[2];
+			float tp = kSphereAxes[0][axis] * p[0] + kSphereAxes[1][axis] * p[1] + kSphereAxes[2][axis] * p[2];
 			float tpmin = tp - r, tpmax = tp + r;
 
 			pmin[axis] = (tpmin < tmin[axis]) ? v : pmin[axis];
@@ -70,6 +143,20 @@ static void computeBoundingSphere(float result[4], const float* points, size_t c
 			tmax[axis] = (tpmax > tmax[axis]) ? tpmax : tmax[axis];
 		}
 	}
+}
+#endif
+
+static void computeBoundingSphere(float result[4], const float* points, size_t count, size_t points_stride, const float* radii, size_t radii_stride, size_t axis_count, const unsigned int* indices = NULL)
+{
+	assert(count > 0);
+	assert(axis_count <= 7);
+
+	size_t points_stride_float = points_stride / sizeof(float);
+	size_t radii_stride_float = radii_stride / sizeof(float);
+
+	// find extremum points along all axes; for each axis we get a pair of points with min/max coordinates
+	unsigned int pmin[8], pmax[8];
+	computeExtremes(pmin, pmax, points, count, points_stride_float, radii, radii_stride_float, axis_count, indices);
 
 	// find the pair of points with largest distance
 	size_t paxis = 0;
@@ -273,6 +360,105 @@ static meshopt_Bounds computeClusterBounds(const unsigned int* indices, size_t i
 	return bounds;
 }
 
+// Batched bounds computation processes meshlets in tasks of this many meshlets
+const size_t kBoundsTaskSize = 1024;
+
+struct BoundsJob
+{
+	meshopt_Bounds* bounds;
+	const meshopt_Meshlet* meshlets;
+	size_t meshlet_count;
+
+	const unsigned int* meshlet_vertices;
+	const unsigned char* meshlet_triangles;
+
+	const float* vertex_positions;
+	size_t vertex_count;
+	size_t vertex_stride_float;
+};
+
+static void computeBoundsTask(void* context, size_t index)
+{
+	const BoundsJob& job = *static_cast<BoundsJob*>(context);
+
+	size_t begin = index * kBoundsTaskSize;
+	size_t end = begin + kBoundsTaskSize < job.meshlet_count ? begin + kBoundsTaskSize : job.meshlet_count;
+
+	// meshlet positions are gathered into a compact array once, so that bounds computation doesn't need to access the vertex buffer through indirection
+	float positions[kMeshletMaxVertices * 3];
+	unsigned int indices[kMeshletMaxTriangles * 3];
+
+	for (size_t i = begin; i < end; ++i)
+	{
+		const meshopt_Meshlet& meshlet = job.meshlets[i];
+		assert(meshlet.triangle_count <= kMeshletMaxTriangles);
+
+		const unsigned int* meshlet_vertices = job.meshlet_vertices + meshlet.vertex_offset;
+		const unsigned char* meshlet_triangles = job.meshlet_triangles + meshlet.triangle_offset;
+
+		size_t corner_count = 0;
+
+		for (size_t j = 0; j < meshlet.triangle_count * 3; ++j)
+		{
+			unsigned char t = meshlet_triangles[j];
+			indices[j] = t;
+
+			// meshlet_vertices[] slice should only contain vertices used by triangle indices, which is the case for any well formed meshlet
+			corner_count = t >= corner_count ? t + 1 : corner_count;
+		}
+
+		for (size_t j = 0; j < corner_count; ++j)
+		{
+			unsigned int v = meshlet_vertices[j];
+			assert(v < job.vertex_count);
+
+			const float* p = job.vertex_positions + v * job.vertex_stride_float;
+
+			positions[j * 3 + 0] = p[0];
+			positions[j * 3 + 1] = p[1];
+			positions[j * 3 + 2] = p[2];
+		}
+
+		job.bounds[i] = computeClusterBounds(indices, meshlet.triangle_count * 3, NULL, corner_count, positions, sizeof(float) * 3);
+	}
+}
+
+static unsigned short quantizeHalfUp(float v)
+{
+	unsigned short h = meshopt_quantizeHalf(v);
+
+	// round to nearest may produce a smaller value; positive halfs are ordered like integers, so next representable value is h+1
+	if (meshopt_dequantizeHalf(h) < v)
+		h++;
+
+	return h;
+}
+
+static meshopt_PackedBounds packBounds(const meshopt_Bounds& bounds)
+{
+	meshopt_PackedBounds result = {};
+
+	float error = 0.f;
+
+	for (int k = 0; k < 3; ++k)
+	{
+		result.center[k] = meshopt_quantizeHalf(bounds.center[k]);
+
+		float delta = meshopt_dequantizeHalf(result.center[k]) - bounds.center[k];
+		error += delta * delta;
+	}
+
+	// the sphere around the quantized center must contain the original sphere
+	result.radius = quantizeHalfUp(bounds.radius + sqrtf(error));
+
+	for (int k = 0; k < 3; ++k)
+		result.cone_axis[k] = bounds.cone_axis_s8[k];
+
+	result.cone_cutoff = bounds.cone_cutoff_s8;
+
+	return result;
+}
+
 } // namespace meshopt
 
 meshopt_Bounds meshopt_computeClusterBounds(const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride)
@@ -336,6 +522,32 @@ meshopt_Bounds meshopt_computeMeshletBounds(const unsigned int* meshlet_vertices
 	return computeClusterBounds(indices, triangle_count * 3, meshlet_vertices, corner_count, vertex_positions, vertex_positions_stride);
 }
 
+void meshopt_computeMeshletBoundsBatch(meshopt_Bounds* bounds, const meshopt_Meshlet* meshlets, size_t meshlet_count, const unsigned int* meshlet_vertices, const unsigned char* meshlet_triangles, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, meshopt_Dispatch dispatch, void* context)
+{
+	using namespace meshopt;
+
+	assert(vertex_positions_stride >= 12 && vertex_positions_stride <= 256);
+	assert(vertex_positions_stride % sizeof(float) == 0);
+
+	BoundsJob job = {};
+	job.bounds = bounds;
+	job.meshlets = meshlets;
+	job.meshlet_count = meshlet_count;
+	job.meshlet_vertices = meshlet_vertices;
+	job.meshlet_triangles = meshlet_triangles;
+	job.vertex_positions = vertex_positions;
+	job.vertex_count = vertex_count;
+	job.vertex_stride_float = vertex_positions_stride / sizeof(float);
+
+	size_t task_count = (meshlet_count + kBoundsTaskSize - 1) / kBoundsTaskSize;
+
+	if (dispatch && task_count > 1)
+		dispatch(context, computeBoundsTask, &job, task_count);
+	else
+		for (size_t i = 0; i < task_count; ++i)
+			computeBoundsTask(&job, i);
+}
+
 meshopt_Bounds meshopt_computeSphereBounds(const float* positions, size_t count, size_t positions_stride, const float* radii, size_t radii_stride)
 {
 	using namespace meshopt;
@@ -617,3 +829,68 @@ size_t meshopt_extractMeshletIndices(unsigned int* vertices, unsigned char* tria
 	assert(unique <= kMeshletMaxVertices);
 	return unique;
 }
+
+void meshopt_packMeshlets(meshopt_PackedMeshlet* packed, void* vertices, size_t vertex_size, void* triangles, size_t triangle_size, meshopt_PackedBounds* bounds, const meshopt_Meshlet* meshlets, size_t meshlet_count, const unsigned int* meshlet_vertices, const unsigned char* meshlet_triangles, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride)
+{
+	using namespace meshopt;
+
+	assert(vertex_size == 2 || vertex_size == 4);
+	assert(vertex_size == 4 || vertex_count <= 65536);
+	assert(triangle_size == 3 || triangle_size == 4);
+	assert(triangle_size == 3 || triangles != meshlet_triangles);
+
+	unsigned char* vertex_data = static_cast<unsigned char*>(vertices);
+	unsigned char* triangle_data = static_cast<unsigned char*>(triangles);
+
+	size_t vertex_offset = 0;
+	size_t triangle_offset = 0;
+
+	for (size_t i = 0; i < meshlet_count; ++i)
+	{
+		meshopt_Meshlet meshlet = meshlets[i];
+		assert(meshlet.vertex_count <= kMeshletMaxVertices && meshlet.triangle_count <= kMeshletMaxTriangles);
+
+		const unsigned int* source_vertices = meshlet_vertices + meshlet.vertex_offset;
+		const unsigned char* source_triangles = meshlet_triangles + meshlet.triangle_offset;
+
+		// bounds need to be computed before packing, as packing may overwrite source data in place
+		if (bounds)
+			bounds[i] = packBounds(meshopt_computeMeshletBounds(source_vertices, source_triangles, meshlet.triangle_count, vertex_positions, vertex_count, vertex_positions_stride));
+
+		// output offsets never exceed input offsets, so copying in order is safe for in-place packing; memcpy is used to avoid aliasing issues
+		for (size_t j = 0; j < meshlet.vertex_count; ++j)
+		{
+			unsigned int v = source_vertices[j];
+			assert(v < vertex_count);
+
+			if (vertex_size == 2)
+			{
+				unsigned short s = (unsigned short)v;
+				memcpy(vertex_data + (vertex_offset + j) * 2, &s, 2);
+			}
+			else
+				memcpy(vertex_data + (vertex_offset + j) * 4, &v, 4);
+		}
+
+		if (triangle_size == 3)
+			memmove(triangle_data + triangle_offset * 3, source_triangles, meshlet.triangle_count * 3);
+		else
+			for (size_t j = 0; j < meshlet.triangle_count; ++j)
+			{
+				unsigned int t = source_triangles[j * 3 + 0] | (source_triangles[j * 3 + 1] << 8) | (source_triangles[j * 3 + 2] << 16);
+				memcpy(triangle_data + (triangle_offset + j) * 4, &t, 4);
+			}
+
+		meshopt_PackedMeshlet& result = packed[i];
+		result.vertex_offset = unsigned(vertex_offset);
+		result.triangle_offset = unsigned(triangle_offset);
+		result.vertex_count = (unsigned short)meshlet.vertex_count;
+		result.triangle_count = (unsigned short)meshlet.triangle_count;
+
+		vertex_offset += meshlet.vertex_count;
+		triangle_offset += meshlet.triangle_count;
+	}
+}
+
+#undef SIMD_SSE
+#undef SIMD_NEON
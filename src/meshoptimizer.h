@@ -50,6 +50,14 @@ struct meshopt_Stream
 	size_t stride;
 };
 
+/**
+ * Experimental: Task dispatch callback used by parallel functions
+ * The library does not create threads; instead, work is split into task_count independent tasks and the callback must call task(task_context, i) for every i in [0, task_count), potentially from multiple threads, returning after all tasks complete.
+ * context is the user pointer passed to the function alongside the callback. Each function documents how often it invokes the callback.
+ * dispatch can be NULL, in which case all tasks are executed serially on the calling thread; results do not depend on the callback or the number of threads.
+ */
+typedef void (*meshopt_Dispatch)(void* context, void (*task)(void* task_context, size_t task_index), void* task_context, size_t task_count);
+
 /**
  * Generates a vertex remap table from the vertex buffer and an optional index buffer and returns number of unique vertices
  * As a result, all vertices that are binary equivalent map to the same (new) location, with no gaps in the resulting sequence.
@@ -271,6 +279,18 @@ MESHOPTIMIZER_API size_t meshopt_optimizeVertexFetchRemap(unsigned int* destinat
 MESHOPTIMIZER_API size_t meshopt_encodeIndexBuffer(unsigned char* buffer, size_t buffer_size, const unsigned int* indices, size_t index_count);
 MESHOPTIMIZER_API size_t meshopt_encodeIndexBufferBound(size_t index_count, size_t vertex_count);
 
+/**
+ * Experimental: Seekable index buffer encoder
+ * Encodes index data just like meshopt_encodeIndexBuffer, producing identical output, and additionally writes a seek table that allows decoding the buffer in parallel via meshopt_decodeIndexBufferParallel.
+ * The seek table captures the decoder state every seek_interval triangles; it is stored separately from the encoded data and takes ~200 bytes per entry.
+ *
+ * buffer must contain enough space for the encoded index buffer (use meshopt_encodeIndexBufferBound to compute worst case size)
+ * seek must contain enough space for the seek table (use meshopt_encodeIndexSeekSize to compute the exact size)
+ * seek_interval is the number of triangles between seek points; values in the range of 10000-100000 are recommended
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_encodeIndexBufferSeekable(unsigned char* buffer, size_t buffer_size, unsigned char* seek, size_t seek_size, const unsigned int* indices, size_t index_count, size_t seek_interval);
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_encodeIndexSeekSize(size_t index_count, size_t seek_interval);
+
 /**
  * Set index encoder format version (defaults to 1)
  * This function is not thread safe and must not be called concurrently with meshopt_encodeIndexBuffer/meshopt_encodeIndexSequence.
@@ -289,6 +309,17 @@ MESHOPTIMIZER_API void meshopt_encodeIndexVersion(int version);
  */
 MESHOPTIMIZER_API int meshopt_decodeIndexBuffer(void* destination, size_t index_count, size_t index_size, const unsigned char* buffer, size_t buffer_size);
 
+/**
+ * Experimental: Parallel index buffer decoder
+ * Decodes index data from an array of bytes generated by meshopt_encodeIndexBufferSeekable, decoding the segments between seek points as independent tasks.
+ * The dispatch callback is invoked once, with one task per seek table entry.
+ * Returns 0 if decoding was successful, and an error code otherwise
+ * The decoder is safe to use for untrusted input (including the seek table), but it may produce garbage data (e.g. out of range indices).
+ *
+ * destination must contain enough space for the resulting index buffer (index_count elements)
+ */
+MESHOPTIMIZER_EXPERIMENTAL int meshopt_decodeIndexBufferParallel(void* destination, size_t index_count, size_t index_size, const unsigned char* buffer, size_t buffer_size, const unsigned char* seek, size_t seek_size, meshopt_Dispatch dispatch, void* context);
+
 /**
  * Get encoded index format version
  * Returns format version of the encoded index buffer/sequence, or -1 if the buffer header is invalid
@@ -349,6 +380,33 @@ MESHOPTIMIZER_API size_t meshopt_encodeMeshletBound(size_t max_vertices, size_t
 MESHOPTIMIZER_API int meshopt_decodeMeshlet(void* vertices, size_t vertex_count, size_t vertex_size, void* triangles, size_t triangle_count, size_t triangle_size, const unsigned char* buffer, size_t buffer_size);
 MESHOPTIMIZER_API int meshopt_decodeMeshletRaw(unsigned int* vertices, size_t vertex_count, unsigned int* triangles, size_t triangle_count, const unsigned char* buffer, size_t buffer_size);
 
+struct meshopt_Meshlet;
+
+/**
+ * Experimental: Batched meshlet decoder
+ * Decodes multiple meshlets generated by meshopt_encodeMeshlet in one call, which is faster than calling meshopt_decodeMeshlet for each meshlet.
+ * Returns 0 if decoding was successful, and an error code otherwise (if any meshlet fails to decode, the remaining meshlets are not decoded)
+ * The decoder is safe to use for untrusted input, but it may produce garbage data.
+ *
+ * meshlets specify vertex/triangle counts that match those used during encoding exactly, as well as output offsets:
+ *   meshlet vertices are written to vertices starting from element vertex_offset, and meshlet triangles are written to triangles starting from triangle triangle_offset / 3 (triangle_offset must be divisible by 3)
+ *   output ranges must not overlap and offsets must increase in meshlet order, which is the case for meshopt_buildMeshlets* output; like meshopt_decodeMeshlet, each meshlet may write up to 3 bytes past the end of its output, which would corrupt the output of an earlier meshlet placed right after it
+ *   as a result, only the last meshlet in each output array needs extra space for these writes
+ * vertex_size and triangle_size have the same meaning as in meshopt_decodeMeshlet; vertices may be NULL if all meshlets have vertex_count = 0
+ * buffer contains the encoded meshlets; encoded data for meshlet i is stored in [buffer_offsets[i]..buffer_offsets[i + 1]), so buffer_offsets must contain meshlet_count + 1 elements
+ */
+MESHOPTIMIZER_EXPERIMENTAL int meshopt_decodeMeshletBatch(void* vertices, size_t vertex_size, void* triangles, size_t triangle_size, const struct meshopt_Meshlet* meshlets, size_t meshlet_count, const unsigned char* buffer, size_t buffer_size, const unsigned int* buffer_offsets);
+
+/**
+ * Experimental: Set meshlet decoder SIMD level (defaults to the highest level supported by the build and the CPU)
+ * By default, meshlet decoding functions use the widest instruction set available at runtime; this function can be used to limit it for testing or benchmarking.
+ * Returns the level that will be used; requested level is clamped to the range of levels supported by the build and the CPU.
+ * This function is not thread safe and must not be called concurrently with meshlet decoding functions.
+ *
+ * level should be 0 (scalar), 1 (128-bit SIMD: SSE4.1 or NEON) or 2 (AVX2)
+ */
+MESHOPTIMIZER_EXPERIMENTAL int meshopt_decodeMeshletSimdLevel(int level);
+
 /**
  * Vertex buffer encoder
  * Encodes vertex data into an array of bytes that is generally smaller and compresses better compared to original.
@@ -376,6 +434,31 @@ MESHOPTIMIZER_API size_t meshopt_encodeVertexBufferBound(size_t vertex_count, si
  */
 MESHOPTIMIZER_API size_t meshopt_encodeVertexBufferLevel(unsigned char* buffer, size_t buffer_size, const void* vertices, size_t vertex_count, size_t vertex_size, int level, int version);
 
+/**
+ * Experimental: Parallel vertex buffer encoder
+ * Encodes vertex data just like meshopt_encodeVertexBufferLevel, producing identical output, but splits the work into independent tasks that can run concurrently.
+ * The dispatch callback is invoked up to three times: to estimate byte rotations (level 3+), to estimate channel encodings (level 2+), and to encode vertex blocks.
+ * Temporary memory proportional to meshopt_encodeVertexBufferBound is allocated through the allocation callbacks on the calling thread.
+ *
+ * buffer must contain enough space for the encoded vertex buffer (use meshopt_encodeVertexBufferBound to compute worst case size)
+ * vertex_size must be a multiple of 4 (and <= 256)
+ * level and version have the same meaning as in meshopt_encodeVertexBufferLevel
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_encodeVertexBufferParallel(unsigned char* buffer, size_t buffer_size, const void* vertices, size_t vertex_count, size_t vertex_size, int level, int version, meshopt_Dispatch dispatch, void* context);
+
+/**
+ * Experimental: Seekable vertex buffer encoder
+ * Encodes vertex data just like meshopt_encodeVertexBufferLevel, producing identical output, and additionally writes a seek table that allows decoding arbitrary vertex ranges via meshopt_decodeVertexBufferRange.
+ * The seek table contains the byte offset and the preceding vertex for each block of the encoded stream; it is stored separately from the encoded data.
+ *
+ * buffer must contain enough space for the encoded vertex buffer (use meshopt_encodeVertexBufferBound to compute worst case size)
+ * seek must contain enough space for the seek table (use meshopt_encodeVertexSeekSize to compute the exact size); seek can be NULL to skip writing the seek table
+ * vertex_size must be a multiple of 4 (and <= 256)
+ * level and version have the same meaning as in meshopt_encodeVertexBufferLevel
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_encodeVertexBufferSeekable(unsigned char* buffer, size_t buffer_size, unsigned char* seek, size_t seek_size, const void* vertices, size_t vertex_count, size_t vertex_size, int level, int version);
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_encodeVertexSeekSize(size_t vertex_count, size_t vertex_size);
+
 /**
  * Set vertex encoder format version (defaults to 1)
  * This function is not thread safe and must not be called concurrently with meshopt_encodeVertexBuffer/meshopt_encodeVertexBufferLevel.
@@ -395,6 +478,76 @@ MESHOPTIMIZER_API void meshopt_encodeVertexVersion(int version);
  */
 MESHOPTIMIZER_API int meshopt_decodeVertexBuffer(void* destination, size_t vertex_count, size_t vertex_size, const unsigned char* buffer, size_t buffer_size);
 
+/**
+ * Experimental: Vertex buffer range decoder
+ * Decodes vertices [first, last) from an array of bytes generated by meshopt_encodeVertexBufferSeekable, using the seek table to skip the blocks before the range.
+ * Returns 0 if decoding was successful, and an error code otherwise
+ * The decoder is safe to use for untrusted input (including the seek table), but it may produce garbage data.
+ * Multiple ranges of the same buffer can be decoded concurrently from different threads.
+ *
+ * destination must contain enough space for the resulting vertices ((last - first) * vertex_size bytes)
+ * vertex_count must be the total number of vertices in the encoded buffer
+ * vertex_size must be a multiple of 4 (and <= 256)
+ */
+MESHOPTIMIZER_EXPERIMENTAL int meshopt_decodeVertexBufferRange(void* destination, size_t first, size_t last, size_t vertex_count, size_t vertex_size, const unsigned char* buffer, size_t buffer_size, const unsigned char* seek, size_t seek_size);
+
+/**
+ * Experimental: Streaming vertex buffer encoder
+ * Encodes vertex data that is supplied incrementally, producing a buffer that can be decoded with meshopt_decodeVertexBuffer; the working set is bounded by the size of the encoder state.
+ * Encoded data is passed to the sink callback as soon as each block is complete; the sink receives consecutive pieces of the encoded buffer and must copy the data it needs to keep.
+ * meshopt_encodeVertexStreamEnd flushes the remaining vertices and the tail, and returns the total encoded size; the total vertex count is available in vertex_count.
+ * For level <= 1 or version 0, the output is identical to meshopt_encodeVertexBufferLevel; at higher levels, channel encodings are selected based on the first block of vertices.
+ *
+ * encoder is initialized by meshopt_encodeVertexStreamBegin; its fields other than vertex_count should be treated as opaque
+ * vertex_size must be a multiple of 4 (and <= 256)
+ * level and version have the same meaning as in meshopt_encodeVertexBufferLevel
+ */
+struct meshopt_VertexStreamEncoder
+{
+	void (*sink)(void* context, const unsigned char* data, size_t size);
+	void* context;
+
+	size_t vertex_size;
+	size_t vertex_count;
+	size_t block_vertices;
+	size_t output_size;
+	int level;
+	int version;
+
+	unsigned char first_vertex[256];
+	unsigned char last_vertex[256];
+	unsigned char channels[64];
+	unsigned char block[8192];
+};
+
+MESHOPTIMIZER_EXPERIMENTAL void meshopt_encodeVertexStreamBegin(struct meshopt_VertexStreamEncoder* encoder, size_t vertex_size, int level, int version, void (*sink)(void* context, const unsigned char* data, size_t size), void* context);
+MESHOPTIMIZER_EXPERIMENTAL void meshopt_encodeVertexStreamAppend(struct meshopt_VertexStreamEncoder* encoder, const void* vertices, size_t vertex_count);
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_encodeVertexStreamEnd(struct meshopt_VertexStreamEncoder* encoder);
+
+/**
+ * Experimental: Reference-primed vertex buffer encoder
+ * Encodes vertex data as a byte-wise difference from a reference vertex buffer, which results in much smaller output when the data is similar to the reference (e.g. morph targets or variants of a base mesh that share vertex order).
+ * Returns encoded data size on success, 0 on error; the only error condition is if buffer doesn't have enough space
+ * Temporary memory proportional to the vertex data size is allocated through the allocation callbacks.
+ * The output can only be decoded with meshopt_decodeVertexBufferRef using the same reference.
+ *
+ * buffer must contain enough space for the encoded vertex buffer (use meshopt_encodeVertexBufferBound to compute worst case size)
+ * reference must contain vertex_count vertices with the same vertex_size; vertex i is encoded relative to reference vertex i
+ * level and version have the same meaning as in meshopt_encodeVertexBufferLevel
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_encodeVertexBufferRef(unsigned char* buffer, size_t buffer_size, const void* vertices, size_t vertex_count, size_t vertex_size, const void* reference, int level, int version);
+
+/**
+ * Experimental: Reference-primed vertex buffer decoder
+ * Decodes vertex data generated by meshopt_encodeVertexBufferRef, adding the reference to each block of vertices as it is decoded.
+ * Returns 0 if decoding was successful, and an error code otherwise
+ * The decoder is safe to use for untrusted input, but it may produce garbage data.
+ *
+ * destination must contain enough space for the resulting vertex buffer (vertex_count * vertex_size bytes) and must not overlap reference
+ * reference must contain the same vertex_count vertices that were used during encoding
+ */
+MESHOPTIMIZER_EXPERIMENTAL int meshopt_decodeVertexBufferRef(void* destination, size_t vertex_count, size_t vertex_size, const unsigned char* buffer, size_t buffer_size, const void* reference);
+
 /**
  * Get encoded vertex format version
  * Returns format version of the encoded vertex buffer, or -1 if the buffer header is invalid
@@ -402,6 +555,16 @@ MESHOPTIMIZER_API int meshopt_decodeVertexBuffer(void* destination, size_t verte
  */
 MESHOPTIMIZER_API int meshopt_decodeVertexVersion(const unsigned char* buffer, size_t buffer_size);
 
+/**
+ * Experimental: Set vertex decoder SIMD level (defaults to the highest level supported by the build and the CPU)
+ * By default, meshopt_decodeVertexBuffer uses the widest instruction set available at runtime; this function can be used to limit it for testing or benchmarking.
+ * Returns the level that will be used; requested level is clamped to the range of levels supported by the build and the CPU.
+ * This function is not thread safe and must not be called concurrently with meshopt_decodeVertexBuffer.
+ *
+ * level should be 0 (scalar), 1 (128-bit SIMD: SSSE3, NEON or Wasm SIMD) or 2 (AVX-512 VBMI2)
+ */
+MESHOPTIMIZER_EXPERIMENTAL int meshopt_decodeVertexSimdLevel(int level);
+
 /**
  * Vertex buffer filters
  * These functions can be used to filter output of meshopt_decodeVertexBuffer in-place.
@@ -423,6 +586,30 @@ MESHOPTIMIZER_API void meshopt_decodeFilterQuat(void* buffer, size_t count, size
 MESHOPTIMIZER_API void meshopt_decodeFilterExp(void* buffer, size_t count, size_t stride);
 MESHOPTIMIZER_API void meshopt_decodeFilterColor(void* buffer, size_t count, size_t stride);
 
+/**
+ * Experimental: Vertex buffer decoder with a fused filter
+ * Decodes vertex data just like meshopt_decodeVertexBuffer and applies the filter to each decoded block of vertices while it's still in cache.
+ * The result is identical to calling meshopt_decodeVertexBuffer followed by the matching meshopt_decodeFilter function, but it only makes one pass over destination memory.
+ * Returns 0 if decoding was successful, and an error code otherwise
+ *
+ * vertex_size is also used as the filter stride and must satisfy the requirements of the selected filter (see above)
+ */
+enum meshopt_DecodeFilter
+{
+	/* No filter; equivalent to meshopt_decodeVertexBuffer */
+	meshopt_DecodeFilterNone,
+	/* meshopt_decodeFilterOct */
+	meshopt_DecodeFilterOct,
+	/* meshopt_decodeFilterQuat */
+	meshopt_DecodeFilterQuat,
+	/* meshopt_decodeFilterExp */
+	meshopt_DecodeFilterExp,
+	/* meshopt_decodeFilterColor */
+	meshopt_DecodeFilterColor,
+};
+
+MESHOPTIMIZER_EXPERIMENTAL int meshopt_decodeVertexBufferFiltered(void* destination, size_t vertex_count, size_t vertex_size, const unsigned char* buffer, size_t buffer_size, enum meshopt_DecodeFilter filter);
+
 /**
  * Vertex buffer filter encoders
  * These functions can be used to encode data in a format that meshopt_decodeFilter can decode
@@ -559,6 +746,158 @@ MESHOPTIMIZER_API size_t meshopt_simplifyWithAttributes(unsigned int* destinatio
  */
 MESHOPTIMIZER_API size_t meshopt_simplifyWithUpdate(unsigned int* indices, size_t index_count, float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, float* vertex_attributes, size_t vertex_attributes_stride, const float* attribute_weights, size_t attribute_count, const unsigned char* vertex_lock, size_t target_index_count, float target_error, unsigned int options, float* result_error);
 
+/**
+ * Experimental: Mesh simplifier with multiple levels of detail
+ * Produces a chain of simplified index buffers from a single simplification run, which is much faster than calling meshopt_simplifyWithAttributes once per level.
+ * Each level continues simplification from the result of the previous level, so levels are nested and may differ from the results of simplifying the original mesh independently.
+ * Returns the number of indices in the last level, with destinations containing index data and destination_counts containing the number of indices for each level
+ *
+ * destinations must contain level_count pointers; each destination must contain enough space for the resulting index buffer, worst case is index_count elements
+ * target_index_counts and target_errors must contain level_count elements; target index counts must be non-increasing and target errors must be non-decreasing
+ * result_errors can be NULL; when it's not NULL, it must contain level_count elements that will receive the resulting error for each level
+ * other parameters have the same meaning as in meshopt_simplifyWithAttributes (vertex_attributes can be NULL if attribute_count is 0)
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_simplifyLevels(unsigned int* const* destinations, size_t* destination_counts, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, const float* vertex_attributes, size_t vertex_attributes_stride, const float* attribute_weights, size_t attribute_count, const unsigned char* vertex_lock, const size_t* target_index_counts, const float* target_errors, size_t level_count, unsigned int options, float* result_errors);
+
+/**
+ * Experimental: Parallel mesh simplifier
+ * Reduces the number of triangles in the mesh just like meshopt_simplifyWithAttributes, producing identical output, but splits edge collapse ranking, sorting and quadric updates of every pass into independent tasks that can run concurrently.
+ * The dispatch callback is invoked several times per pass.
+ *
+ * parameters have the same meaning as in meshopt_simplifyWithAttributes (vertex_attributes can be NULL if attribute_count is 0)
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_simplifyParallel(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, const float* vertex_attributes, size_t vertex_attributes_stride, const float* attribute_weights, size_t attribute_count, const unsigned char* vertex_lock, size_t target_index_count, float target_error, unsigned int options, float* result_error, meshopt_Dispatch dispatch, void* context);
+
+/**
+ * Experimental: Tiled mesh simplifier
+ * Reduces the number of triangles in the mesh like meshopt_simplifyWithAttributes, but splits the mesh into spatially coherent tiles that are simplified independently, which bounds the temporary memory to be proportional to the tile size.
+ * Vertices with positions shared between tiles (including copies along attribute seams) are locked during each pass; subsequent passes re-partition the result into larger tiles to simplify the seams, until the target is reached or a pass can't make further progress.
+ * The index buffer is reordered in place in destination and only tile-local data is accessed during simplification, so indices and vertex data can reside in memory-mapped files for meshes that don't fit in memory.
+ * Returns the number of indices after simplification, with destination containing new index data
+ *
+ * destination must contain enough space for the source index buffer (since optimization is iterative, this means index_count elements - *not* target_index_count!)
+ * max_tile_triangles is the maximum number of triangles in each tile; the temporary memory used per tile is roughly proportional to it, with additional 9 bytes per vertex (plus a position hash table that is built once)
+ * result_error can be NULL; when it's not NULL, it will contain the maximum error of individual tile simplifications; note that seams are simplified in multiple passes, so the error there can accumulate
+ * other parameters have the same meaning as in meshopt_simplifyWithAttributes (vertex_attributes can be NULL if attribute_count is 0)
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_simplifyTiled(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, const float* vertex_attributes, size_t vertex_attributes_stride, const float* attribute_weights, size_t attribute_count, const unsigned char* vertex_lock, size_t target_index_count, float target_error, unsigned int options, size_t max_tile_triangles, float* result_error);
+
+/**
+ * Experimental: Vertex collapse performed by the simplifier, see meshopt_simplifyProgressive
+ */
+struct meshopt_VertexCollapse
+{
+	/* vertex that is removed by the collapse and the vertex it is merged into */
+	unsigned int vertex;
+	unsigned int target;
+
+	/* simplification error after the collapse */
+	float error;
+
+	/* number of collapses in the same group, starting from this one; a group moves all wedges of one position and must be applied as a whole */
+	unsigned int group;
+};
+
+/**
+ * Experimental: Progressive mesh simplifier
+ * Simplifies the mesh like meshopt_simplifyWithAttributes, but instead of the simplified index buffer outputs the sequence of vertex collapses that the simplifier performed.
+ * A prefix of the sequence can be applied to the source index buffer with meshopt_generateProgressiveIndices, which allows continuous refinement and coarsening between the source mesh and the simplified mesh without storing discrete levels of detail.
+ * The prefix must end at a group boundary (collapse_count is 0 or the last included collapse has group == 1); otherwise attribute seams may split apart. Prefixes that include all collapses up to a given error are always safe, as all collapses in a group share the error.
+ * Applying the entire sequence produces the same index buffer as meshopt_simplifyWithAttributes with the same parameters.
+ * Returns the number of vertex collapses
+ *
+ * collapses must contain enough space for the resulting sequence, worst case is vertex_count elements; each collapse removes one vertex, and all wedges of a position are collapsed together in consecutive elements
+ * error of each collapse is the error of the mesh after this collapse is applied, in the same units as result_error; errors are non-decreasing
+ * options must not include meshopt_SimplifyPrune since component pruning removes triangles without vertex collapses
+ * other parameters have the same meaning as in meshopt_simplifyWithAttributes (vertex_attributes can be NULL if attribute_count is 0)
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_simplifyProgressive(struct meshopt_VertexCollapse* collapses, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, const float* vertex_attributes, size_t vertex_attributes_stride, const float* attribute_weights, size_t attribute_count, const unsigned char* vertex_lock, size_t target_index_count, float target_error, unsigned int options, float* result_error);
+
+/**
+ * Experimental: Progressive mesh index buffer generator
+ * Applies the first collapse_count collapses produced by meshopt_simplifyProgressive to the source index buffer, removing triangles that become degenerate.
+ * collapse_count should end at a group boundary, see meshopt_simplifyProgressive.
+ * Returns the number of indices in the resulting index buffer; triangle order is preserved.
+ *
+ * destination must contain enough space for the resulting index buffer (index_count elements); it can be equal to indices
+ * indices and vertex_count must match the values passed to meshopt_simplifyProgressive
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_generateProgressiveIndices(unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count, const struct meshopt_VertexCollapse* collapses, size_t collapse_count);
+
+/**
+ * Experimental: Reusable mesh simplifier context
+ * Precomputes topology-derived data (position remap, vertex classification, edge loops) and position quadrics once, so that the mesh can be simplified many times with different targets and attribute weights via meshopt_simplifyWithContext, paying only for attribute quadrics and the edge collapse loop on each run.
+ * Source data is copied into the context and doesn't need to be kept alive; the context must be destroyed with meshopt_simplifyContextDestroy.
+ * Returns the new context; it is immutable after creation, so it's safe to run several simplifications with the same context concurrently.
+ *
+ * options are fixed for all simplifications performed with the context and have the same meaning as in meshopt_simplifyWithAttributes
+ * other parameters have the same meaning as in meshopt_simplifyWithAttributes (vertex_attributes can be NULL if attribute_count is 0); attribute weights are provided separately for each run
+ */
+struct meshopt_SimplifyContext;
+
+MESHOPTIMIZER_EXPERIMENTAL struct meshopt_SimplifyContext* meshopt_simplifyContextCreate(const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, const float* vertex_attributes, size_t vertex_attributes_stride, size_t attribute_count, const unsigned char* vertex_lock, unsigned int options);
+MESHOPTIMIZER_EXPERIMENTAL void meshopt_simplifyContextDestroy(struct meshopt_SimplifyContext* context);
+
+/**
+ * Experimental: Mesh simplifier that reuses data precomputed by meshopt_simplifyContextCreate
+ * Produces the same result as meshopt_simplifyWithAttributes called with the source data and options of the context.
+ * Returns the number of indices after simplification, with destination containing new index data
+ *
+ * destination must contain enough space for the source index buffer (since optimization is iterative, this means index_count elements - *not* target_index_count!)
+ * attribute_weights should have attribute_count floats in total as specified when creating the context; it can be NULL if attribute_count is 0
+ * other parameters have the same meaning as in meshopt_simplifyWithAttributes
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_simplifyWithContext(unsigned int* destination, const struct meshopt_SimplifyContext* context, const float* attribute_weights, size_t target_index_count, float target_error, float* result_error);
+
+/**
+ * Experimental: Memory-budgeted mesh simplifier
+ * Reduces the number of triangles in the mesh like meshopt_simplifyWithAttributes, but limits the memory used for attribute quadrics, which otherwise grows by ~20 bytes per vertex for every attribute.
+ * When the budget doesn't fit all attributes, weighted attributes are projected onto fewer principal components, dropping the ones with the least variance first; attribute error is approximated with the remaining components.
+ * When the budget fits all attributes, the result is the same as meshopt_simplifyWithAttributes.
+ * Returns the number of indices after simplification, with destination containing new index data
+ *
+ * memory_budget is the number of bytes the simplifier may allocate; memory required for positions and topology is always allocated, so only attribute storage is limited by the budget
+ * result_memory can be NULL; when it's not NULL, it will contain the upper bound of the peak memory allocated during simplification in bytes
+ * other parameters have the same meaning as in meshopt_simplifyWithAttributes (vertex_attributes can be NULL if attribute_count is 0)
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_simplifyWithBudget(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, const float* vertex_attributes, size_t vertex_attributes_stride, const float* attribute_weights, size_t attribute_count, const unsigned char* vertex_lock, size_t target_index_count, float target_error, unsigned int options, size_t memory_budget, float* result_error, size_t* result_memory);
+
+/**
+ * Experimental: Mesh descriptor for meshopt_simplifyBatch
+ * Fields have the same meaning as the corresponding parameters of meshopt_simplifyWithAttributes (vertex_attributes and attribute_weights can be NULL if attribute_count is 0, vertex_lock can be NULL)
+ */
+struct meshopt_SimplifyBatchMesh
+{
+	unsigned int* destination;
+	const unsigned int* indices;
+	size_t index_count;
+
+	const float* vertex_positions;
+	size_t vertex_count;
+	size_t vertex_positions_stride;
+
+	const float* vertex_attributes;
+	size_t vertex_attributes_stride;
+	const float* attribute_weights;
+	size_t attribute_count;
+
+	const unsigned char* vertex_lock;
+
+	size_t target_index_count;
+	float target_error;
+};
+
+/**
+ * Experimental: Batch mesh simplifier
+ * Simplifies many independent meshes with the same options, producing the same results as calling meshopt_simplifyWithAttributes for each mesh.
+ * Consecutive small meshes are grouped into larger tasks; the dispatch callback is invoked once.
+ * Returns the total number of indices after simplification; result_counts receives the number of indices for each mesh, with each mesh destination containing new index data
+ *
+ * result_counts must contain mesh_count elements; result_errors can be NULL, when it's not NULL it must contain mesh_count elements that will receive the resulting error for each mesh
+ * destination buffers must not overlap; each must contain enough space for the source index buffer of the mesh (index_count elements)
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_simplifyBatch(size_t* result_counts, float* result_errors, const struct meshopt_SimplifyBatchMesh* meshes, size_t mesh_count, unsigned int options, meshopt_Dispatch dispatch, void* context);
+
 /**
  * Mesh simplifier (sloppy)
  * Reduces the number of triangles in the mesh, sacrificing mesh appearance for simplification performance
@@ -575,6 +914,16 @@ MESHOPTIMIZER_API size_t meshopt_simplifyWithUpdate(unsigned int* indices, size_
  */
 MESHOPTIMIZER_API size_t meshopt_simplifySloppy(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, const unsigned char* vertex_lock, size_t target_index_count, float target_error, float* result_error);
 
+/**
+ * Experimental: Parallel mesh simplifier (sloppy)
+ * Reduces the number of triangles in the mesh like meshopt_simplifySloppy, but searches for the grid size by evaluating several candidate sizes in each round, so that the target is found in a few rounds of concurrent work instead of a sequence of serial probes.
+ * The dispatch callback is invoked once per round.
+ * The search may settle on a different grid size than meshopt_simplifySloppy, so results are not identical to it.
+ *
+ * parameters have the same meaning as in meshopt_simplifySloppy
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_simplifySloppyParallel(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, const unsigned char* vertex_lock, size_t target_index_count, float target_error, float* result_error, meshopt_Dispatch dispatch, void* context);
+
 /**
  * Mesh simplifier (pruner)
  * Reduces the number of triangles in the mesh by removing small isolated parts of the mesh
@@ -756,6 +1105,37 @@ MESHOPTIMIZER_API size_t meshopt_buildMeshletsFlex(struct meshopt_Meshlet* meshl
  */
 MESHOPTIMIZER_API size_t meshopt_buildMeshletsSpatial(struct meshopt_Meshlet* meshlets, unsigned int* meshlet_vertices, unsigned char* meshlet_triangles, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t max_vertices, size_t min_triangles, size_t max_triangles, float fill_weight);
 
+/**
+ * Experimental: Parallel meshlet builder
+ * Splits the mesh into a set of meshlets like meshopt_buildMeshletsFlex, but first partitions the mesh into spatially coherent chunks of up to 32768 triangles that are clusterized independently and concatenated in order; meshlets never cross chunk boundaries.
+ * The dispatch callback is invoked once; meshes with up to 32768 triangles produce the same result as meshopt_buildMeshletsFlex.
+ *
+ * meshlets must contain enough space for all meshlets, worst case size is meshopt_buildMeshletsBound using min_triangles, plus index_count / 49152 + 1 to account for chunk boundaries
+ * other parameters have the same meaning and limits as in meshopt_buildMeshletsFlex
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_buildMeshletsParallel(struct meshopt_Meshlet* meshlets, unsigned int* meshlet_vertices, unsigned char* meshlet_triangles, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t max_vertices, size_t min_triangles, size_t max_triangles, float cone_weight, float split_factor, meshopt_Dispatch dispatch, void* context);
+
+/**
+ * Experimental: Parallel spatial meshlet builder
+ * Splits the mesh into a set of meshlets like meshopt_buildMeshletsSpatial and produces the same result, but evaluates the top levels of the split tree and the independent subtrees below them in parallel tasks.
+ * The dispatch callback is invoked once to sort the triangles, twice for every node in the top levels of the split tree, and once for the subtrees below them.
+ *
+ * other parameters have the same meaning and limits as in meshopt_buildMeshletsSpatial
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_buildMeshletsSpatialParallel(struct meshopt_Meshlet* meshlets, unsigned int* meshlet_vertices, unsigned char* meshlet_triangles, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t max_vertices, size_t min_triangles, size_t max_triangles, float fill_weight, meshopt_Dispatch dispatch, void* context);
+
+/**
+ * Experimental: Streaming meshlet builder
+ * Splits the mesh into a set of meshlets like meshopt_buildMeshletsFlex, but consumes triangles in windows of window_size triangles in index buffer order and emits finished meshlets through a callback, so that memory usage only depends on window_size and not on the mesh size.
+ * Triangles of the last meshlet of each window are clusterized again together with the next window. To get good clusters, triangles should be spatially coherent in index buffer order, e.g. by using meshopt_spatialSortTriangles beforehand.
+ * Returns the total number of meshlets emitted.
+ *
+ * window_size should be much larger than max_triangles; 65536 is a reasonable default
+ * callback is called once per meshlet; meshlet offsets are zero, meshlet_vertices contains vertex_count indices into the source vertex buffer and meshlet_triangles contains triangle_count*3 micro-indices, which are only valid until the callback returns
+ * other parameters have the same meaning and limits as in meshopt_buildMeshletsFlex
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_buildMeshletsStream(const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t max_vertices, size_t min_triangles, size_t max_triangles, float cone_weight, float split_factor, size_t window_size, void (*callback)(void* context, const struct meshopt_Meshlet* meshlet, const unsigned int* meshlet_vertices, const unsigned char* meshlet_triangles), void* context);
+
 /**
  * Meshlet optimizer
  * Reorders meshlet vertices and triangles to maximize locality which can improve rasterizer throughput or ray tracing performance when using fast-build modes.
@@ -817,6 +1197,16 @@ struct meshopt_Bounds
 MESHOPTIMIZER_API struct meshopt_Bounds meshopt_computeClusterBounds(const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride);
 MESHOPTIMIZER_API struct meshopt_Bounds meshopt_computeMeshletBounds(const unsigned int* meshlet_vertices, const unsigned char* meshlet_triangles, size_t triangle_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride);
 
+/**
+ * Experimental: Batched cluster bounds generator
+ * Computes bounds for all meshlets in one call; bounds[i] is equal to the result of meshopt_computeMeshletBounds for meshlets[i].
+ * The dispatch callback is invoked once.
+ *
+ * bounds must contain enough space for meshlet_count elements
+ * other parameters have the same meaning and limits as in meshopt_computeMeshletBounds
+ */
+MESHOPTIMIZER_EXPERIMENTAL void meshopt_computeMeshletBoundsBatch(struct meshopt_Bounds* bounds, const struct meshopt_Meshlet* meshlets, size_t meshlet_count, const unsigned int* meshlet_vertices, const unsigned char* meshlet_triangles, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, meshopt_Dispatch dispatch, void* context);
+
 /**
  * Sphere bounds generator
  * Creates bounding sphere around a set of points or a set of spheres; returns the center and radius of the sphere, with other fields of the result set to 0.
@@ -837,6 +1227,46 @@ MESHOPTIMIZER_API struct meshopt_Bounds meshopt_computeSphereBounds(const float*
  */
 MESHOPTIMIZER_API size_t meshopt_extractMeshletIndices(unsigned int* vertices, unsigned char* triangles, const unsigned int* indices, size_t index_count);
 
+/**
+ * Experimental: Compact meshlet layout
+ * Packed meshlets store offsets and counts in 12 bytes instead of 16; bounds store the bounding sphere in half-precision and the normal cone in 8-bit SNORM format, using 12 bytes instead of 64.
+ */
+struct meshopt_PackedMeshlet
+{
+	/* offsets within vertex and triangle arrays with meshlet data, in vertices and triangles respectively */
+	unsigned int vertex_offset;
+	unsigned int triangle_offset;
+
+	/* number of vertices and triangles used in the meshlet */
+	unsigned short vertex_count;
+	unsigned short triangle_count;
+};
+
+struct meshopt_PackedBounds
+{
+	/* bounding sphere, stored as half-precision floats; decode using meshopt_dequantizeHalf. radius is rounded up to account for the center quantization error */
+	unsigned short center[3];
+	unsigned short radius;
+
+	/* normal cone axis and cutoff, stored in 8-bit SNORM format; decode using x/127.0 */
+	signed char cone_axis[3];
+	signed char cone_cutoff;
+};
+
+/**
+ * Experimental: Meshlet packer
+ * Converts meshlets produced by meshopt_buildMeshlets* into a compact layout with separate arrays for meshlet headers, vertex references, triangles and bounds; this is a separate pass over builder output, which the builders do not produce directly.
+ * Meshlet data is stored contiguously in meshlet order, like the builders store it; the size reduction comes from the smaller headers and bounds, and from 16-bit vertex references when vertex_size is 2.
+ * Bounds are computed using meshopt_computeMeshletBounds and quantized as described in meshopt_PackedBounds; cone_apex is not stored, so culling should use the formula based on the bounding sphere.
+ *
+ * packed must contain enough space for meshlet_count elements
+ * vertices must contain enough space for the total number of meshlet vertices, vertex_size bytes each; vertex_size must be 2 (16-bit vertex references, requires vertex_count <= 65536) or 4 (32-bit vertex references)
+ * triangles must contain enough space for the total number of meshlet triangles, triangle_size bytes each; triangle_size must be 3 (8-bit triangle indices) or 4 (32-bit packed triangles, stored as (a) | (b << 8) | (c << 16))
+ * vertices and triangles may alias meshlet_vertices and meshlet_triangles for in-place packing (except for triangle_size = 4) as long as meshlets are sorted by offsets, which is the case for meshopt_buildMeshlets* output
+ * bounds can be NULL; when it's not NULL, it must contain enough space for meshlet_count elements and vertex_positions should have float3 position in the first 12 bytes of each vertex, with coordinates within half-precision range
+ */
+MESHOPTIMIZER_EXPERIMENTAL void meshopt_packMeshlets(struct meshopt_PackedMeshlet* packed, void* vertices, size_t vertex_size, void* triangles, size_t triangle_size, struct meshopt_PackedBounds* bounds, const struct meshopt_Meshlet* meshlets, size_t meshlet_count, const unsigned int* meshlet_vertices, const unsigned char* meshlet_triangles, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride);
+
 /**
  * Cluster partitioner
  * Partitions clusters into groups of similar size, prioritizing grouping clusters that share vertices or are close to each other.
@@ -1391,14 +1391,15 @@ static void rankEdgeCollapses(Collapse* collapses, size_t collapse_count, const
 		if (attribute_count)
 		{
 			ei += quadricError(attribute_quadrics[i0], &attribute_gradients[i0 * attribute_count], attribute_count, vertex_positions[i1], &vertex_attributes[i1 * attribute_count]);
-			ej += bidi ? quadricError(attribute_quadrics[i1], &attribute_gradients[i1 * attribute_count], attribute_count, vertex_positions[i0], &vertex_attributes[i0 * attribute_count]) : 0;
 
 			// seam edges need to aggregate attribute errors between primary and secondary edges, as attribute quadrics are separate
+			unsigned int s0 = 0, s1 = 0;
+
 			if (vertex_kind[i0] == Kind_Seam)
 			{
 				// for seam collapses we need to find the seam pair; this is a bit tricky since we need to rely on edge loops as target vertex may be locked (and thus have more than two wedges)
-				unsigned int s0 = wedge[i0];
-				unsigned int s1 = loop[i0] == i1 ? loopback[s0] : loop[s0];
+				s0 = wedge[i0];
+				s1 = loop[i0] == i1 ? loopback[s0] : loop[s0];
 
 				assert(wedge[s0] == i0); // s0 may be equal to i0 for half-seams
 				assert(s1 != ~0u && remap[s1] == remap[i1]);
@@ -1407,20 +1408,26 @@ static void rankEdgeCollapses(Collapse* collapses, size_t collapse_count, const
 				s1 = (s1 != ~0u) ? s1 : wedge[i1];
 
 				ei += quadricError(attribute_quadrics[s0], &attribute_gradients[s0 * attribute_count], attribute_count, vertex_positions[s1], &vertex_attributes[s1 * attribute_count]);
-				ej += bidi ? quadricError(attribute_quadrics[s1], &attribute_gradients[s1 * attribute_count], attribute_count, vertex_positions[s0], &vertex_attributes[s0 * attribute_count]) : 0;
 			}
-			else
+			else if (vertex_kind[i0] == Kind_Complex)
 			{
 				// complex edges can have multiple wedges, so we need to aggregate errors for all wedges based on the selected target
-				if (vertex_kind[i0] == Kind_Complex)
-					for (unsigned int v = wedge[i0]; v != i0; v = wedge[v])
-					{
-						unsigned int t = getComplexTarget(v, i1, remap, loop, loopback);
+				for (unsigned int v = wedge[i0]; v != i0; v = wedge[v])
+				{
+					unsigned int t = getComplexTarget(v, i1, remap, loop, loopback);
 
-						ei += quadricError(attribute_quadrics[v], &attribute_gradients[v * attribute_count], attribute_count, vertex_positions[t], &vertex_attributes[t * attribute_count]);
-					}
+					ei += quadricError(attribute_quadrics[v], &attribute_gradients[v * attribute_count], attribute_count, vertex_positions[t], &vertex_attributes[t * attribute_count]);
+				}
+			}
+
+			// attribute errors are non-negative, so reverse attribute errors are only needed if reverse position error is smaller than the forward error
+			if (bidi && ej < ei)
+			{
+				ej += quadricError(attribute_quadrics[i1], &attribute_gradients[i1 * attribute_count], attribute_count, vertex_positions[i0], &vertex_attributes[i0 * attribute_count]);
 
-				if (vertex_kind[i1] == Kind_Complex && bidi)
+				if (vertex_kind[i0] == Kind_Seam)
+					ej += quadricError(attribute_quadrics[s1], &attribute_gradients[s1 * attribute_count], attribute_count, vertex_positions[s0], &vertex_attributes[s0 * attribute_count]);
+				else if (vertex_kind[i1] == Kind_Complex)
 					for (unsigned int v = wedge[i1]; v != i1; v = wedge[v])
 					{
 						unsigned int t = getComplexTarget(v, i0, remap, loop, loopback);
@@ -1449,32 +1456,33 @@ static void rankEdgeCollapses(Collapse* collapses, size_t collapse_count, const
 	}
 }
 
-static void sortEdgeCollapses(unsigned int* sort_order, const Collapse* collapses, size_t collapse_count)
+// we use counting sort to order collapses by error; since the exact sort order is not as critical,
+// only top 12 bits of exponent+mantissa (8 bits of exponent and 4 bits of mantissa) are used.
+// to avoid excessive stack usage, we clamp the exponent range as collapses with errors much higher than 1 are not useful.
+const unsigned int kCollapseSortBits = 12;
+const unsigned int kCollapseSortBins = 2048 + 512; // exponent range [-127, 32)
+
+static unsigned int getCollapseSortKey(const Collapse& c)
 {
-	// we use counting sort to order collapses by error; since the exact sort order is not as critical,
-	// only top 12 bits of exponent+mantissa (8 bits of exponent and 4 bits of mantissa) are used.
-	// to avoid excessive stack usage, we clamp the exponent range as collapses with errors much higher than 1 are not useful.
-	const unsigned int sort_bits = 12;
-	const unsigned int sort_bins = 2048 + 512; // exponent range [-127, 32)
+	// skip sign bit since error is non-negative
+	unsigned int key = (c.errorui << 1) >> (32 - kCollapseSortBits);
+
+	return key < kCollapseSortBins ? key : kCollapseSortBins - 1;
+}
 
+static void sortEdgeCollapses(unsigned int* sort_order, const Collapse* collapses, size_t collapse_count)
+{
 	// fill histogram for counting sort
-	unsigned int histogram[sort_bins];
+	unsigned int histogram[kCollapseSortBins];
 	memset(histogram, 0, sizeof(histogram));
 
 	for (size_t i = 0; i < collapse_count; ++i)
-	{
-		// skip sign bit since error is non-negative
-		unsigned int error = collapses[i].errorui;
-		unsigned int key = (error << 1) >> (32 - sort_bits);
-		key = key < sort_bins ? key : sort_bins - 1;
-
-		histogram[key]++;
-	}
+		histogram[getCollapseSortKey(collapses[i])]++;
 
 	// compute offsets based on histogram data
 	size_t histogram_sum = 0;
 
-	for (size_t i = 0; i < sort_bins; ++i)
+	for (size_t i = 0; i < kCollapseSortBins; ++i)
 	{
 		size_t count = histogram[i];
 		histogram[i] = unsigned(histogram_sum);
@@ -1485,17 +1493,10 @@ static void sortEdgeCollapses(unsigned int* sort_order, const Collapse* collapse
 
 	// compute sort order based on offsets
 	for (size_t i = 0; i < collapse_count; ++i)
-	{
-		// skip sign bit since error is non-negative
-		unsigned int error = collapses[i].errorui;
-		unsigned int key = (error << 1) >> (32 - sort_bits);
-		key = key < sort_bins ? key : sort_bins - 1;
-
-		sort_order[histogram[key]++] = unsigned(i);
-	}
+		sort_order[histogram[getCollapseSortKey(collapses[i])]++] = unsigned(i);
 }
 
-static size_t performEdgeCollapses(unsigned int* collapse_remap, unsigned char* collapse_locked, const Collapse* collapses, size_t collapse_count, const unsigned int* collapse_order, const unsigned int* remap, const unsigned int* wedge, const unsigned char* vertex_kind, const unsigned int* loop, const unsigned int* loopback, const Vector3* vertex_positions, const EdgeAdjacency& adjacency, size_t triangle_collapse_goal, float error_limit, float& result_error)
+static size_t performEdgeCollapses(unsigned int* collapse_remap, unsigned char* collapse_locked, const Collapse* collapses, size_t collapse_count, const unsigned int* collapse_order, const unsigned int* remap, const unsigned int* wedge, const unsigned char* vertex_kind, const unsigned int* loop, const unsigned int* loopback, const Vector3* vertex_positions, const EdgeAdjacency& adjacency, size_t triangle_collapse_goal, float error_limit, float& result_error, unsigned int* collapse_log)
 {
 	size_t edge_collapses = 0;
 	size_t triangle_collapses = 0;
@@ -1615,6 +1616,10 @@ static size_t performEdgeCollapses(unsigned int* collapse_remap, unsigned char*
 		collapse_locked[r0] = 1;
 		collapse_locked[r1] = 1;
 
+		// collapse log is used to record the collapse sequence for progressive meshes
+		if (collapse_log)
+			collapse_log[edge_collapses] = collapse_order[i];
+
 		// border edges collapse 1 triangle, other edges collapse 2 or more
 		triangle_collapses += (kind == Kind_Border) ? 1 : 2;
 		edge_collapses++;
@@ -1672,6 +1677,179 @@ static void updateQuadrics(const unsigned int* collapse_remap, size_t vertex_cou
 	}
 }
 
+// number of vertices, triangles or collapses processed by each parallel simplification task
+// task boundaries don't depend on the number of threads, and all tasks produce results that match the serial code exactly
+const size_t kSimplifyTaskSize = 32768;
+
+struct SimplifyJob
+{
+	size_t vertex_count;
+	const Vector3* vertex_positions;
+	const float* vertex_attributes;
+	size_t attribute_count;
+	const unsigned int* remap;
+	const unsigned int* wedge;
+	const unsigned char* vertex_kind;
+	const unsigned int* loop;
+	const unsigned int* loopback;
+
+	Quadric* vertex_quadrics;
+	QuadricGrad* volume_gradients;
+	Quadric* attribute_quadrics;
+	QuadricGrad* attribute_gradients;
+
+	Collapse* collapses;
+	size_t collapse_count;
+	unsigned int* collapse_order;
+	unsigned int* sort_histograms;
+
+	const unsigned int* collapse_remap;
+	float* task_errors;
+};
+
+static void runSimplifyTasks(meshopt_Dispatch dispatch, void* context, void (*task)(void*, size_t), SimplifyJob& job, size_t item_count)
+{
+	size_t task_count = (item_count + kSimplifyTaskSize - 1) / kSimplifyTaskSize;
+
+	if (task_count)
+		dispatch(context, task, &job, task_count);
+}
+
+static void rankEdgeCollapsesTask(void* context, size_t index)
+{
+	const SimplifyJob& job = *static_cast<SimplifyJob*>(context);
+
+	size_t begin = index * kSimplifyTaskSize;
+	size_t end = begin + kSimplifyTaskSize < job.collapse_count ? begin + kSimplifyTaskSize : job.collapse_count;
+
+	rankEdgeCollapses(job.collapses + begin, end - begin, job.vertex_positions, job.vertex_attributes, job.vertex_quadrics, job.attribute_quadrics, job.attribute_gradients, job.attribute_count, job.remap, job.wedge, job.vertex_kind, job.loop, job.loopback);
+}
+
+static void countEdgeCollapsesTask(void* context, size_t index)
+{
+	const SimplifyJob& job = *static_cast<SimplifyJob*>(context);
+
+	size_t begin = index * kSimplifyTaskSize;
+	size_t end = begin + kSimplifyTaskSize < job.collapse_count ? begin + kSimplifyTaskSize : job.collapse_count;
+
+	unsigned int* histogram = &job.sort_histograms[index * kCollapseSortBins];
+	memset(histogram, 0, kCollapseSortBins * sizeof(unsigned int));
+
+	for (size_t i = begin; i < end; ++i)
+		histogram[getCollapseSortKey(job.collapses[i])]++;
+}
+
+static void orderEdgeCollapsesTask(void* context, size_t index)
+{
+	const SimplifyJob& job = *static_cast<SimplifyJob*>(context);
+
+	size_t begin = index * kSimplifyTaskSize;
+	size_t end = begin + kSimplifyTaskSize < job.collapse_count ? begin + kSimplifyTaskSize : job.collapse_count;
+
+	unsigned int* histogram = &job.sort_histograms[index * kCollapseSortBins];
+
+	for (size_t i = begin; i < end; ++i)
+		job.collapse_order[histogram[getCollapseSortKey(job.collapses[i])]++] = unsigned(i);
+}
+
+static void sortEdgeCollapses(unsigned int* sort_order, SimplifyJob& job, meshopt_Dispatch dispatch, void* context)
+{
+	size_t task_count = (job.collapse_count + kSimplifyTaskSize - 1) / kSimplifyTaskSize;
+
+	job.collapse_order = sort_order;
+
+	runSimplifyTasks(dispatch, context, countEdgeCollapsesTask, job, job.collapse_count);
+
+	// compute offsets for each task so that the resulting order matches the serial (stable) counting sort
+	size_t histogram_sum = 0;
+
+	for (size_t i = 0; i < kCollapseSortBins; ++i)
+		for (size_t j = 0; j < task_count; ++j)
+		{
+			size_t count = job.sort_histograms[j * kCollapseSortBins + i];
+			job.sort_histograms[j * kCollapseSortBins + i] = unsigned(histogram_sum);
+			histogram_sum += count;
+		}
+
+	assert(histogram_sum == job.collapse_count);
+
+	runSimplifyTasks(dispatch, context, orderEdgeCollapsesTask, job, job.collapse_count);
+}
+
+static void updateQuadricsTask(void* context, size_t index)
+{
+	const SimplifyJob& job = *static_cast<SimplifyJob*>(context);
+
+	size_t begin = index * kSimplifyTaskSize;
+	size_t end = begin + kSimplifyTaskSize < job.vertex_count ? begin + kSimplifyTaskSize : job.vertex_count;
+
+	const unsigned int* collapse_remap = job.collapse_remap;
+	const unsigned int* remap = job.remap;
+	const unsigned int* wedge = job.wedge;
+	size_t attribute_count = job.attribute_count;
+
+	float vertex_error = 0;
+
+	// each collapse moves all wedges of a source position to wedges of a locked target position, so no two collapses write to the same quadric
+	// to avoid conflicts, the task that owns the primary source vertex updates all quadrics for its wedges in the same order as updateQuadrics
+	for (size_t i = begin; i < end; ++i)
+	{
+		if (remap[i] != i || (collapse_remap[i] == i && wedge[i] == i))
+			continue;
+
+		unsigned int r0 = unsigned(i);
+
+		if (collapse_remap[r0] != r0)
+		{
+			unsigned int r1 = remap[collapse_remap[r0]];
+
+			quadricAdd(job.vertex_quadrics[r1], job.vertex_quadrics[r0]);
+
+			if (job.volume_gradients)
+				quadricAdd(job.volume_gradients[r1], job.volume_gradients[r0]);
+
+			if (attribute_count)
+			{
+				float derr = quadricError(job.vertex_quadrics[r0], job.vertex_positions[r1]);
+				vertex_error = vertex_error < derr ? derr : vertex_error;
+			}
+		}
+
+		if (attribute_count)
+		{
+			// visit wedges in increasing index order; primary vertex has the smallest index and wedge lists are short
+			for (unsigned int i0 = r0; i0 != ~0u;)
+			{
+				unsigned int next = ~0u;
+				for (unsigned int v = wedge[i0]; v != i0; v = wedge[v])
+					next = (v > i0 && v < next) ? v : next;
+
+				unsigned int i1 = collapse_remap[i0];
+
+				if (i1 != i0)
+				{
+					quadricAdd(job.attribute_quadrics[i1], job.attribute_quadrics[i0]);
+					quadricAdd(&job.attribute_gradients[i1 * attribute_count], &job.attribute_gradients[i0 * attribute_count], attribute_count);
+				}
+
+				i0 = next;
+			}
+		}
+	}
+
+	job.task_errors[index] = vertex_error;
+}
+
+static void updateQuadrics(SimplifyJob& job, meshopt_Dispatch dispatch, void* context, float& vertex_error)
+{
+	size_t task_count = (job.vertex_count + kSimplifyTaskSize - 1) / kSimplifyTaskSize;
+
+	runSimplifyTasks(dispatch, context, updateQuadricsTask, job, job.vertex_count);
+
+	for (size_t i = 0; i < task_count; ++i)
+		vertex_error = vertex_error < job.task_errors[i] ? job.task_errors[i] : vertex_error;
+}
+
 static void solvePositions(Vector3* vertex_positions, size_t vertex_count, const Quadric* vertex_quadrics, const QuadricGrad* volume_gradients, const Quadric* attribute_quadrics, const QuadricGrad* attribute_gradients, size_t attribute_count, const unsigned int* remap, const unsigned int* wedge, const EdgeAdjacency& adjacency, const unsigned char* vertex_kind, const unsigned char* vertex_update)
 {
 #if TRACE
@@ -2084,24 +2262,27 @@ struct TriangleHasher
 	}
 };
 
+static unsigned int computeVertexId(const Vector3* vertex_positions, const unsigned char* vertex_lock, unsigned int i, float cell_scale)
+{
+	const Vector3& v = vertex_positions[i];
+
+	int xi = int(v.x * cell_scale + 0.5f);
+	int yi = int(v.y * cell_scale + 0.5f);
+	int zi = int(v.z * cell_scale + 0.5f);
+
+	if (vertex_lock && (vertex_lock[i] & meshopt_SimplifyVertex_Lock))
+		return (1 << 30) | i;
+	else
+		return (xi << 20) | (yi << 10) | zi;
+}
+
 static void computeVertexIds(unsigned int* vertex_ids, const Vector3* vertex_positions, const unsigned char* vertex_lock, size_t vertex_count, int grid_size)
 {
 	assert(grid_size >= 1 && grid_size <= 1024);
 	float cell_scale = float(grid_size - 1);
 
 	for (size_t i = 0; i < vertex_count; ++i)
-	{
-		const Vector3& v = vertex_positions[i];
-
-		int xi = int(v.x * cell_scale + 0.5f);
-		int yi = int(v.y * cell_scale + 0.5f);
-		int zi = int(v.z * cell_scale + 0.5f);
-
-		if (vertex_lock && (vertex_lock[i] & meshopt_SimplifyVertex_Lock))
-			vertex_ids[i] = (1 << 30) | unsigned(i);
-		else
-			vertex_ids[i] = (xi << 20) | (yi << 10) | zi;
-	}
+		vertex_ids[i] = computeVertexId(vertex_positions, vertex_lock, unsigned(i), cell_scale);
 }
 
 static size_t countTriangles(const unsigned int* vertex_ids, const unsigned int* indices, size_t index_count)
@@ -2332,316 +2513,1365 @@ static float interpolate(float y, float x0, float y0, float x1, float y1, float
 	return x1 + (den == 0.f ? 0.f : num / den);
 }
 
-} // namespace meshopt
-
-// Note: this is only exposed for development purposes; do *not* use
-enum
+// clusters vertices with the given ids into cells and remaps each cell to its best vertex; triangle_count is the number of triangles that survive clustering
+static size_t simplifySloppyGrid(unsigned int* destination, const unsigned int* indices, size_t index_count, const Vector3* vertex_positions, size_t vertex_count, const unsigned int* vertex_ids, int grid_size, size_t triangle_count, float* out_result_error)
 {
-	meshopt_SimplifyInternalSolve = 1 << 29,
-	meshopt_SimplifyInternalDebug = 1 << 30
-};
+	(void)grid_size;
 
-size_t meshopt_simplifyEdge(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride, const float* vertex_attributes_data, size_t vertex_attributes_stride, const float* attribute_weights, size_t attribute_count, const unsigned char* vertex_lock, size_t target_index_count, float target_error, unsigned int options, float* out_result_error)
-{
-	using namespace meshopt;
+	meshopt_Allocator allocator;
 
-	assert(index_count % 3 == 0);
-	assert(vertex_positions_stride >= 12 && vertex_positions_stride <= 256);
-	assert(vertex_positions_stride % sizeof(float) == 0);
-	assert(target_index_count <= index_count);
-	assert(target_error >= 0);
-	assert(vertex_attributes_stride >= attribute_count * sizeof(float) && vertex_attributes_stride <= 256);
-	assert(vertex_attributes_stride % sizeof(float) == 0);
-	assert(attribute_count <= kMaxAttributes);
-	for (size_t i = 0; i < attribute_count; ++i)
-		assert(attribute_weights[i] >= 0);
+	if (triangle_count == 0)
+	{
+		if (out_result_error)
+			*out_result_error = 1.f;
 
-	meshopt_Allocator allocator;
+		return 0;
+	}
 
-	unsigned int* result = destination;
-	if (result != indices)
-		memcpy(result, indices, index_count * sizeof(unsigned int));
+	// build vertex->cell association by mapping all vertices with the same quantized position to the same cell
+	size_t table_size = hashBuckets2(vertex_count);
+	unsigned int* table = allocator.allocate<unsigned int>(table_size);
 
-	// build an index remap and update indices/vertex_count to minimize the subsequent work
-	// note: as a consequence, errors will be computed relative to the subset extent
-	unsigned int* sparse_remap = NULL;
-	if (options & meshopt_SimplifySparse)
-		sparse_remap = buildSparseRemap(result, index_count, vertex_count, &vertex_count, allocator);
+	unsigned int* vertex_cells = allocator.allocate<unsigned int>(vertex_count);
 
-	// build adjacency information
-	EdgeAdjacency adjacency = {};
-	prepareEdgeAdjacency(adjacency, index_count, vertex_count, allocator);
-	updateEdgeAdjacency(adjacency, result, index_count, vertex_count, NULL);
+	size_t cell_count = fillVertexCells(table, table_size, vertex_cells, vertex_ids, vertex_count);
 
-	// build position remap that maps each vertex to the one with identical position
-	// wedge table stores next vertex with identical position for each vertex
-	unsigned int* remap = allocator.allocate<unsigned int>(vertex_count);
-	unsigned int* wedge = allocator.allocate<unsigned int>(vertex_count);
-	buildPositionRemap(remap, wedge, vertex_positions_data, vertex_count, vertex_positions_stride, sparse_remap, allocator);
+	// build a quadric for each target cell
+	Quadric* cell_quadrics = allocator.allocate<Quadric>(cell_count);
+	memset(cell_quadrics, 0, cell_count * sizeof(Quadric));
 
-	// classify vertices; vertex kind determines collapse rules, see kCanCollapse
-	unsigned char* vertex_kind = allocator.allocate<unsigned char>(vertex_count);
-	unsigned int* loop = allocator.allocate<unsigned int>(vertex_count);
-	unsigned int* loopback = allocator.allocate<unsigned int>(vertex_count);
-	classifyVertices(vertex_kind, loop, loopback, vertex_count, adjacency, remap, wedge, vertex_lock, sparse_remap, options);
+	fillCellQuadrics(cell_quadrics, indices, index_count, vertex_positions, vertex_cells);
 
-#if TRACE
-	size_t unique_positions = 0;
-	for (size_t i = 0; i < vertex_count; ++i)
-		unique_positions += remap[i] == i;
+	// for each target cell, find the vertex with the minimal error
+	unsigned int* cell_remap = allocator.allocate<unsigned int>(cell_count);
+	float* cell_errors = allocator.allocate<float>(cell_count);
 
-	printf("position remap: %d vertices => %d positions\n", int(vertex_count), int(unique_positions));
+	fillCellRemap(cell_remap, cell_errors, cell_count, vertex_cells, cell_quadrics, vertex_positions, vertex_count);
 
-	size_t kinds[Kind_Count] = {};
-	for (size_t i = 0; i < vertex_count; ++i)
-		kinds[vertex_kind[i]] += remap[i] == i;
+	// compute error
+	float result_error = 0.f;
 
-	printf("kinds: manifold %d, border %d, seam %d, complex %d, locked %d\n",
-	    int(kinds[Kind_Manifold]), int(kinds[Kind_Border]), int(kinds[Kind_Seam]), int(kinds[Kind_Complex]), int(kinds[Kind_Locked]));
-#endif
+	for (size_t i = 0; i < cell_count; ++i)
+		result_error = result_error < cell_errors[i] ? cell_errors[i] : result_error;
 
-	Vector3* vertex_positions = allocator.allocate<Vector3>(vertex_count);
-	float vertex_offset[3] = {};
-	float vertex_scale = rescalePositions(vertex_positions, vertex_positions_data, vertex_count, vertex_positions_stride, sparse_remap, vertex_offset);
+	// vertex collapses often result in duplicate triangles; we need a table to filter them out
+	size_t tritable_size = hashBuckets2(triangle_count);
+	unsigned int* tritable = allocator.allocate<unsigned int>(tritable_size);
 
-	float* vertex_attributes = NULL;
-	unsigned int attribute_remap[kMaxAttributes];
+	// note: this is the first and last write to destination, which allows aliasing destination with indices
+	size_t write = filterTriangles(destination, tritable, tritable_size, indices, index_count, vertex_cells, cell_remap);
 
-	if (attribute_count)
-	{
-		// remap attributes to only include ones with weight > 0 to minimize memory/compute overhead for quadrics
-		size_t attributes_used = 0;
-		for (size_t i = 0; i < attribute_count; ++i)
-			if (attribute_weights[i] > 0)
-				attribute_remap[attributes_used++] = unsigned(i);
+#if TRACE
+	printf("result: grid size %d, %d cells, %d triangles (%d unfiltered), error %e\n", grid_size, int(cell_count), int(write / 3), int(triangle_count), sqrtf(result_error));
+#endif
 
-		attribute_count = attributes_used;
-		vertex_attributes = allocator.allocate<float>(vertex_count * attribute_count);
-		rescaleAttributes(vertex_attributes, vertex_attributes_data, vertex_count, vertex_attributes_stride, attribute_weights, attribute_count, attribute_remap, sparse_remap);
-	}
+	if (out_result_error)
+		*out_result_error = sqrtf(result_error);
 
-	Quadric* vertex_quadrics = allocator.allocate<Quadric>(vertex_count);
-	memset(vertex_quadrics, 0, vertex_count * sizeof(Quadric));
+	return write;
+}
 
-	Quadric* attribute_quadrics = NULL;
-	QuadricGrad* attribute_gradients = NULL;
-	QuadricGrad* volume_gradients = NULL;
+// number of grid sizes evaluated by each round of the parallel sloppy grid search
+const size_t kSloppyGridCandidates = 8;
 
-	if (attribute_count)
-	{
-		attribute_quadrics = allocator.allocate<Quadric>(vertex_count);
-		memset(attribute_quadrics, 0, vertex_count * sizeof(Quadric));
+struct SloppyJob
+{
+	const unsigned int* indices;
+	size_t index_count;
+	const Vector3* vertex_positions;
+	const unsigned char* vertex_lock;
+	size_t vertex_count;
 
-		attribute_gradients = allocator.allocate<QuadricGrad>(vertex_count * attribute_count);
-		memset(attribute_gradients, 0, vertex_count * attribute_count * sizeof(QuadricGrad));
+	int grid_sizes[kSloppyGridCandidates + 1];
+	size_t grid_count;
+	size_t chunk_count;
+	size_t* chunk_triangles;
 
-		if (options & meshopt_SimplifyInternalSolve)
-		{
-			volume_gradients = allocator.allocate<QuadricGrad>(vertex_count);
-			memset(volume_gradients, 0, vertex_count * sizeof(QuadricGrad));
-		}
-	}
+	unsigned int* vertex_ids;
+};
 
-	fillFaceQuadrics(vertex_quadrics, volume_gradients, result, index_count, vertex_positions, remap);
-	fillVertexQuadrics(vertex_quadrics, vertex_positions, vertex_count, remap, vertex_lock, sparse_remap, options);
-	fillEdgeQuadrics(vertex_quadrics, result, index_count, vertex_positions, remap, vertex_kind, loop, loopback);
+static void countGridTrianglesTask(void* context, size_t index)
+{
+	const SloppyJob& job = *static_cast<SloppyJob*>(context);
 
-	if (attribute_count)
-		fillAttributeQuadrics(attribute_quadrics, attribute_gradients, result, index_count, vertex_positions, vertex_attributes, attribute_count);
+	size_t grid = index / job.chunk_count;
+	size_t chunk = index % job.chunk_count;
 
-	unsigned int* components = NULL;
-	float* component_errors = NULL;
-	size_t component_count = 0;
-	float component_nexterror = 0;
+	size_t begin = chunk * kSimplifyTaskSize * 3;
+	size_t end = begin + kSimplifyTaskSize * 3 < job.index_count ? begin + kSimplifyTaskSize * 3 : job.index_count;
 
-	if (options & meshopt_SimplifyPrune)
-	{
-		components = allocator.allocate<unsigned int>(vertex_count);
-		component_count = buildComponents(components, vertex_count, result, index_count, remap);
+	assert(job.grid_sizes[grid] >= 1 && job.grid_sizes[grid] <= 1024);
+	float cell_scale = float(job.grid_sizes[grid] - 1);
 
-		component_errors = allocator.allocate<float>(component_count * 4); // overallocate for temporary use inside measureComponents
-		measureComponents(component_errors, component_count, components, vertex_positions, vertex_count);
+	// same as countTriangles, but vertex ids are recomputed for each corner so that grid sizes don't need separate id buffers
+	size_t result = 0;
 
-		component_nexterror = FLT_MAX;
-		for (size_t i = 0; i < component_count; ++i)
-			component_nexterror = component_nexterror > component_errors[i] ? component_errors[i] : component_nexterror;
+	for (size_t i = begin; i < end; i += 3)
+	{
+		unsigned int id0 = computeVertexId(job.vertex_positions, job.vertex_lock, job.indices[i + 0], cell_scale);
+		unsigned int id1 = computeVertexId(job.vertex_positions, job.vertex_lock, job.indices[i + 1], cell_scale);
+		unsigned int id2 = computeVertexId(job.vertex_positions, job.vertex_lock, job.indices[i + 2], cell_scale);
 
-#if TRACE
-		printf("components: %d (min error %e)\n", int(component_count), sqrtf(component_nexterror));
-#endif
+		result += (id0 != id1) & (id0 != id2) & (id1 != id2);
 	}
 
-#if TRACE
-	size_t pass_count = 0;
-#endif
+	job.chunk_triangles[index] = result;
+}
 
-	size_t collapse_capacity = boundEdgeCollapses(adjacency, vertex_count, index_count, vertex_kind);
+static void computeVertexIdsTask(void* context, size_t index)
+{
+	const SloppyJob& job = *static_cast<SloppyJob*>(context);
 
-	Collapse* edge_collapses = allocator.allocate<Collapse>(collapse_capacity);
-	unsigned int* collapse_order = allocator.allocate<unsigned int>(collapse_capacity);
-	unsigned int* collapse_remap = allocator.allocate<unsigned int>(vertex_count);
+	size_t begin = index * kSimplifyTaskSize;
+	size_t end = begin + kSimplifyTaskSize < job.vertex_count ? begin + kSimplifyTaskSize : job.vertex_count;
+
+	assert(job.grid_sizes[0] >= 1 && job.grid_sizes[0] <= 1024);
+	float cell_scale = float(job.grid_sizes[0] - 1);
+
+	for (size_t i = begin; i < end; ++i)
+		job.vertex_ids[i] = computeVertexId(job.vertex_positions, job.vertex_lock, unsigned(i), cell_scale);
+}
+
+static void runSloppyTasks(meshopt_Dispatch dispatch, void* context, void (*task)(void*, size_t), SloppyJob& job, size_t task_count)
+{
+	if (dispatch && task_count > 1)
+		dispatch(context, task, &job, task_count);
+	else
+		for (size_t i = 0; i < task_count; ++i)
+			task(&job, i);
+}
+
+static float getTriangleCenter(const unsigned int* indices, size_t triangle, const float* vertex_positions, size_t vertex_stride_float, int axis)
+{
+	// sum is sufficient for ordering and avoids a division
+	const unsigned int* tri = &indices[triangle * 3];
+
+	return vertex_positions[tri[0] * vertex_stride_float + axis] + vertex_positions[tri[1] * vertex_stride_float + axis] + vertex_positions[tri[2] * vertex_stride_float + axis];
+}
+
+static void swapTriangles(unsigned int* indices, size_t a, size_t b)
+{
+	for (int k = 0; k < 3; ++k)
+	{
+		unsigned int t = indices[a * 3 + k];
+		indices[a * 3 + k] = indices[b * 3 + k];
+		indices[b * 3 + k] = t;
+	}
+}
+
+// reorders triangles in [begin, end) in place so that triangles before nth have smaller or equal centers along axis than triangles after nth
+static void selectTriangles(unsigned int* indices, size_t begin, size_t nth, size_t end, const float* vertex_positions, size_t vertex_stride_float, int axis)
+{
+	while (end - begin > 2)
+	{
+		// median of three pivot selection helps with partially sorted inputs which are common for scanned data
+		float a = getTriangleCenter(indices, begin, vertex_positions, vertex_stride_float, axis);
+		float b = getTriangleCenter(indices, begin + (end - begin) / 2, vertex_positions, vertex_stride_float, axis);
+		float c = getTriangleCenter(indices, end - 1, vertex_positions, vertex_stride_float, axis);
+		float pivot = a < b ? (b < c ? b : (a < c ? c : a)) : (a < c ? a : (b < c ? c : b));
+
+		size_t i = begin, j = end - 1;
+
+		for (;;)
+		{
+			while (getTriangleCenter(indices, i, vertex_positions, vertex_stride_float, axis) < pivot)
+				i++;
+			while (getTriangleCenter(indices, j, vertex_positions, vertex_stride_float, axis) > pivot)
+				j--;
+
+			if (i >= j)
+				break;
+
+			swapTriangles(indices, i, j);
+			i++, j--;
+		}
+
+		// [begin, j] <= pivot <= [j + 1, end)
+		if (nth <= j)
+			end = j + 1;
+		else
+			begin = j + 1;
+	}
+
+	if (end - begin == 2 && getTriangleCenter(indices, begin, vertex_positions, vertex_stride_float, axis) > getTriangleCenter(indices, begin + 1, vertex_positions, vertex_stride_float, axis))
+		swapTriangles(indices, begin, begin + 1);
+}
+
+// splits triangles in [begin, end) into tiles of at most max_triangles by recursively partitioning them in place at the median along the longest axis
+static void partitionTiles(size_t* tile_offsets, size_t& tile_count, unsigned int* indices, size_t begin, size_t end, const float* vertex_positions, size_t vertex_stride_float, size_t max_triangles)
+{
+	if (end - begin <= max_triangles)
+	{
+		tile_offsets[tile_count++] = begin;
+		return;
+	}
+
+	float minv[3] = {FLT_MAX, FLT_MAX, FLT_MAX};
+	float maxv[3] = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+
+	for (size_t i = begin; i < end; ++i)
+		for (int k = 0; k < 3; ++k)
+		{
+			float v = getTriangleCenter(indices, i, vertex_positions, vertex_stride_float, k);
+
+			minv[k] = minv[k] < v ? minv[k] : v;
+			maxv[k] = maxv[k] > v ? maxv[k] : v;
+		}
+
+	int axis = (maxv[0] - minv[0] >= maxv[1] - minv[1] && maxv[0] - minv[0] >= maxv[2] - minv[2]) ? 0 : (maxv[1] - minv[1] >= maxv[2] - minv[2] ? 1 : 2);
+
+	size_t middle = begin + (end - begin) / 2;
+	selectTriangles(indices, begin, middle, end, vertex_positions, vertex_stride_float, axis);
+
+	partitionTiles(tile_offsets, tile_count, indices, begin, middle, vertex_positions, vertex_stride_float, max_triangles);
+	partitionTiles(tile_offsets, tile_count, indices, middle, end, vertex_positions, vertex_stride_float, max_triangles);
+}
+
+static void decomposeSymmetric(float* A, float* V, size_t n)
+{
+	// cyclic Jacobi rotations; on return, diagonal of A contains eigenvalues and rows of V contain corresponding eigenvectors
+	float total = 0;
+
+	for (size_t i = 0; i < n; ++i)
+		for (size_t j = 0; j < n; ++j)
+		{
+			V[i * n + j] = i == j ? 1.f : 0.f;
+			total += A[i * n + j] * A[i * n + j];
+		}
+
+	for (int sweep = 0; sweep < 16; ++sweep)
+	{
+		float off = 0;
+
+		for (size_t p = 0; p < n; ++p)
+			for (size_t q = p + 1; q < n; ++q)
+				off += A[p * n + q] * A[p * n + q];
+
+		if (off <= total * 1e-12f)
+			break;
+
+		for (size_t p = 0; p < n; ++p)
+			for (size_t q = p + 1; q < n; ++q)
+			{
+				float apq = A[p * n + q];
+				if (apq == 0)
+					continue;
+
+				// rotation angle that zeroes A[p][q]
+				float theta = (A[q * n + q] - A[p * n + p]) / (2 * apq);
+				float t = (theta >= 0 ? 1.f : -1.f) / (fabsf(theta) + sqrtf(theta * theta + 1));
+				float c = 1 / sqrtf(t * t + 1), s = t * c;
+
+				for (size_t k = 0; k < n; ++k)
+				{
+					float akp = A[k * n + p], akq = A[k * n + q];
+					A[k * n + p] = c * akp - s * akq;
+					A[k * n + q] = s * akp + c * akq;
+				}
+
+				for (size_t k = 0; k < n; ++k)
+				{
+					float apk = A[p * n + k], aqk = A[q * n + k];
+					A[p * n + k] = c * apk - s * aqk;
+					A[q * n + k] = s * apk + c * aqk;
+				}
+
+				for (size_t k = 0; k < n; ++k)
+				{
+					float vpk = V[p * n + k], vqk = V[q * n + k];
+					V[p * n + k] = c * vpk - s * vqk;
+					V[q * n + k] = s * vpk + c * vqk;
+				}
+			}
+	}
+}
+
+static void compressAttributes(float* result, size_t component_count, const float* vertex_attributes_data, size_t vertex_count, size_t vertex_attributes_stride, const float* attribute_weights, const unsigned int* attribute_remap, size_t attribute_count)
+{
+	// attribute error is a sum of squared differences of weighted attributes, which is invariant to translation and rotation of the attribute space
+	// this allows us to project weighted attributes onto principal components and keep the ones with the largest variance
+	size_t vertex_attributes_stride_float = vertex_attributes_stride / sizeof(float);
+	size_t n = attribute_count;
+
+	float mean[kMaxAttributes] = {};
+	float covariance[kMaxAttributes * kMaxAttributes] = {};
+	float basis[kMaxAttributes * kMaxAttributes];
+
+	for (size_t i = 0; i < vertex_count; ++i)
+		for (size_t k = 0; k < n; ++k)
+			mean[k] += vertex_attributes_data[i * vertex_attributes_stride_float + attribute_remap[k]] * attribute_weights[attribute_remap[k]];
+
+	for (size_t k = 0; k < n; ++k)
+		mean[k] /= float(vertex_count);
+
+	for (size_t i = 0; i < vertex_count; ++i)
+	{
+		float va[kMaxAttributes];
+
+		for (size_t k = 0; k < n; ++k)
+			va[k] = vertex_attributes_data[i * vertex_attributes_stride_float + attribute_remap[k]] * attribute_weights[attribute_remap[k]] - mean[k];
+
+		for (size_t k = 0; k < n; ++k)
+			for (size_t l = k; l < n; ++l)
+				covariance[k * n + l] += va[k] * va[l];
+	}
+
+	for (size_t k = 0; k < n; ++k)
+		for (size_t l = 0; l < k; ++l)
+			covariance[k * n + l] = covariance[l * n + k];
+
+	decomposeSymmetric(covariance, basis, n);
+
+	// order components by decreasing variance
+	unsigned int order[kMaxAttributes];
+	for (size_t k = 0; k < n; ++k)
+		order[k] = unsigned(k);
+
+	for (size_t k = 0; k < component_count; ++k)
+		for (size_t l = k + 1; l < n; ++l)
+			if (covariance[order[l] * n + order[l]] > covariance[order[k] * n + order[k]])
+			{
+				unsigned int t = order[k];
+				order[k] = order[l];
+				order[l] = t;
+			}
+
+	for (size_t i = 0; i < vertex_count; ++i)
+	{
+		float va[kMaxAttributes];
+
+		for (size_t k = 0; k < n; ++k)
+			va[k] = vertex_attributes_data[i * vertex_attributes_stride_float + attribute_remap[k]] * attribute_weights[attribute_remap[k]] - mean[k];
+
+		for (size_t j = 0; j < component_count; ++j)
+		{
+			const float* axis = &basis[order[j] * n];
+			float c = 0;
+
+			for (size_t k = 0; k < n; ++k)
+				c += va[k] * axis[k];
+
+			result[i * component_count + j] = c;
+		}
+	}
+}
+
+} // namespace meshopt
+
+// Note: this is only exposed for development purposes; do *not* use
+enum
+{
+	meshopt_SimplifyInternalSolve = 1 << 29,
+	meshopt_SimplifyInternalDebug = 1 << 30
+};
+
+namespace meshopt
+{
+
+struct SimplifyMesh
+{
+	size_t vertex_count;
+	unsigned int* sparse_remap;
+
+	unsigned int* remap;
+	unsigned int* wedge;
+	unsigned char* vertex_kind;
+	unsigned int* loop;
+	unsigned int* loopback;
+
+	Vector3* vertex_positions;
+	float vertex_scale;
+	float vertex_offset[3];
+
+	Quadric* vertex_quadrics;
+	QuadricGrad* volume_gradients;
+};
+
+// computes topology-derived data and position quadrics that only depend on the source mesh; indices are converted to the sparse space in place
+static void prepareSimplifyMesh(SimplifyMesh& mesh, EdgeAdjacency& adjacency, unsigned int* indices, size_t index_count, const float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride, const unsigned char* vertex_lock, unsigned int options, bool volume_gradients, meshopt_Allocator& allocator)
+{
+	// build an index remap and update indices/vertex_count to minimize the subsequent work
+	// note: as a consequence, errors will be computed relative to the subset extent
+	unsigned int* sparse_remap = NULL;
+	if (options & meshopt_SimplifySparse)
+		sparse_remap = buildSparseRemap(indices, index_count, vertex_count, &vertex_count, allocator);
+
+	// build adjacency information
+	prepareEdgeAdjacency(adjacency, index_count, vertex_count, allocator);
+	updateEdgeAdjacency(adjacency, indices, index_count, vertex_count, NULL);
+
+	// build position remap that maps each vertex to the one with identical position
+	// wedge table stores next vertex with identical position for each vertex
+	unsigned int* remap = allocator.allocate<unsigned int>(vertex_count);
+	unsigned int* wedge = allocator.allocate<unsigned int>(vertex_count);
+	buildPositionRemap(remap, wedge, vertex_positions_data, vertex_count, vertex_positions_stride, sparse_remap, allocator);
+
+	// classify vertices; vertex kind determines collapse rules, see kCanCollapse
+	unsigned char* vertex_kind = allocator.allocate<unsigned char>(vertex_count);
+	unsigned int* loop = allocator.allocate<unsigned int>(vertex_count);
+	unsigned int* loopback = allocator.allocate<unsigned int>(vertex_count);
+	classifyVertices(vertex_kind, loop, loopback, vertex_count, adjacency, remap, wedge, vertex_lock, sparse_remap, options);
+
+#if TRACE
+	size_t unique_positions = 0;
+	for (size_t i = 0; i < vertex_count; ++i)
+		unique_positions += remap[i] == i;
+
+	printf("position remap: %d vertices => %d positions\n", int(vertex_count), int(unique_positions));
+
+	size_t kinds[Kind_Count] = {};
+	for (size_t i = 0; i < vertex_count; ++i)
+		kinds[vertex_kind[i]] += remap[i] == i;
+
+	printf("kinds: manifold %d, border %d, seam %d, complex %d, locked %d\n",
+	    int(kinds[Kind_Manifold]), int(kinds[Kind_Border]), int(kinds[Kind_Seam]), int(kinds[Kind_Complex]), int(kinds[Kind_Locked]));
+#endif
+
+	Vector3* vertex_positions = allocator.allocate<Vector3>(vertex_count);
+	float vertex_offset[3] = {};
+	float vertex_scale = rescalePositions(vertex_positions, vertex_positions_data, vertex_count, vertex_positions_stride, sparse_remap, vertex_offset);
+
+	Quadric* vertex_quadrics = allocator.allocate<Quadric>(vertex_count);
+	memset(vertex_quadrics, 0, vertex_count * sizeof(Quadric));
+
+	QuadricGrad* volume_gradients_data = NULL;
+
+	if (volume_gradients)
+	{
+		volume_gradients_data = allocator.allocate<QuadricGrad>(vertex_count);
+		memset(volume_gradients_data, 0, vertex_count * sizeof(QuadricGrad));
+	}
+
+	fillFaceQuadrics(vertex_quadrics, volume_gradients_data, indices, index_count, vertex_positions, remap);
+	fillVertexQuadrics(vertex_quadrics, vertex_positions, vertex_count, remap, vertex_lock, sparse_remap, options);
+	fillEdgeQuadrics(vertex_quadrics, indices, index_count, vertex_positions, remap, vertex_kind, loop, loopback);
+
+	mesh.vertex_count = vertex_count;
+	mesh.sparse_remap = sparse_remap;
+	mesh.remap = remap;
+	mesh.wedge = wedge;
+	mesh.vertex_kind = vertex_kind;
+	mesh.loop = loop;
+	mesh.loopback = loopback;
+	mesh.vertex_positions = vertex_positions;
+	mesh.vertex_scale = vertex_scale;
+	memcpy(mesh.vertex_offset, vertex_offset, sizeof(vertex_offset));
+	mesh.vertex_quadrics = vertex_quadrics;
+	mesh.volume_gradients = volume_gradients_data;
+}
+
+// simplifies the mesh towards each target in order, copying each level to its destination once it's complete
+// subsequent levels continue from the state of the previous level, so topology data and quadrics are only computed once
+// vertex quadrics, edge loops and adjacency are updated in place; returns the index count of the last level which is left in result in sparse space
+static size_t simplifyMesh(unsigned int* const* destinations, size_t* destination_counts, unsigned int* result, size_t index_count, SimplifyMesh& mesh, EdgeAdjacency& adjacency, const float* vertex_attributes, Quadric* attribute_quadrics, QuadricGrad* attribute_gradients, size_t attribute_count, const size_t* target_index_counts, const float* target_errors, size_t level_count, unsigned int options, float* out_result_errors, meshopt_Dispatch dispatch, void* context, meshopt_VertexCollapse* out_collapses, size_t* out_collapse_count)
+{
+	size_t vertex_count = mesh.vertex_count;
+	const unsigned int* sparse_remap = mesh.sparse_remap;
+	unsigned int* remap = mesh.remap;
+	unsigned int* wedge = mesh.wedge;
+	unsigned char* vertex_kind = mesh.vertex_kind;
+	unsigned int* loop = mesh.loop;
+	unsigned int* loopback = mesh.loopback;
+	Vector3* vertex_positions = mesh.vertex_positions;
+	float vertex_scale = mesh.vertex_scale;
+	Quadric* vertex_quadrics = mesh.vertex_quadrics;
+	QuadricGrad* volume_gradients = mesh.volume_gradients;
+
+	meshopt_Allocator allocator;
+
+	unsigned int* components = NULL;
+	float* component_errors = NULL;
+	size_t component_count = 0;
+	float component_nexterror = 0;
+
+	if (options & meshopt_SimplifyPrune)
+	{
+		components = allocator.allocate<unsigned int>(vertex_count);
+		component_count = buildComponents(components, vertex_count, result, index_count, remap);
+
+		component_errors = allocator.allocate<float>(component_count * 4); // overallocate for temporary use inside measureComponents
+		measureComponents(component_errors, component_count, components, vertex_positions, vertex_count);
+
+		component_nexterror = FLT_MAX;
+		for (size_t i = 0; i < component_count; ++i)
+			component_nexterror = component_nexterror > component_errors[i] ? component_errors[i] : component_nexterror;
+
+#if TRACE
+		printf("components: %d (min error %e)\n", int(component_count), sqrtf(component_nexterror));
+#endif
+	}
+
+#if TRACE
+	size_t pass_count = 0;
+#endif
+
+	size_t collapse_capacity = boundEdgeCollapses(adjacency, vertex_count, index_count, vertex_kind);
+
+	Collapse* edge_collapses = allocator.allocate<Collapse>(collapse_capacity);
+	unsigned int* collapse_order = allocator.allocate<unsigned int>(collapse_capacity);
+	unsigned int* collapse_remap = allocator.allocate<unsigned int>(vertex_count);
 	unsigned char* collapse_locked = allocator.allocate<unsigned char>(vertex_count);
 
+	unsigned int* collapse_log = out_collapses ? allocator.allocate<unsigned int>(vertex_count) : NULL;
+	size_t collapse_log_count = 0;
+	float collapse_log_error = 0;
+
+	SimplifyJob job = {};
+
+	if (dispatch)
+	{
+		job.vertex_count = vertex_count;
+		job.vertex_positions = vertex_positions;
+		job.vertex_attributes = vertex_attributes;
+		job.attribute_count = attribute_count;
+		job.remap = remap;
+		job.wedge = wedge;
+		job.vertex_kind = vertex_kind;
+		job.loop = loop;
+		job.loopback = loopback;
+		job.vertex_quadrics = vertex_quadrics;
+		job.volume_gradients = volume_gradients;
+		job.attribute_quadrics = attribute_quadrics;
+		job.attribute_gradients = attribute_gradients;
+		job.collapses = edge_collapses;
+		job.collapse_remap = collapse_remap;
+		job.sort_histograms = allocator.allocate<unsigned int>((collapse_capacity + kSimplifyTaskSize - 1) / kSimplifyTaskSize * kCollapseSortBins);
+		job.task_errors = allocator.allocate<float>((vertex_count + kSimplifyTaskSize - 1) / kSimplifyTaskSize);
+	}
+
+	size_t result_count = index_count;
+	float result_error = 0;
+	float vertex_error = 0;
+
+	// target_error input is linear; we need to adjust it to match quadricError units
+	float error_scale = (options & meshopt_SimplifyErrorAbsolute) ? vertex_scale : 1.f;
+
+	for (size_t level = 0; level < level_count; ++level)
+	{
+		size_t target_index_count = target_index_counts[level];
+		float error_limit = (target_errors[level] * target_errors[level]) / (error_scale * error_scale);
+
+		while (result_count > target_index_count)
+		{
+			// note: throughout the simplification process adjacency structure reflects welded topology for result-in-progress
+			updateEdgeAdjacency(adjacency, result, result_count, vertex_count, remap);
+
+			size_t edge_collapse_count = pickEdgeCollapses(edge_collapses, collapse_capacity, result, result_count, remap, vertex_kind, loop, loopback);
+			assert(edge_collapse_count <= collapse_capacity);
+
+			// no edges can be collapsed any more due to topology restrictions
+			if (edge_collapse_count == 0)
+				break;
+
+#if TRACE
+			printf("pass %d:%c", int(pass_count++), TRACE >= 2 ? '\n' : ' ');
+#endif
+
+			if (dispatch)
+			{
+				job.collapse_count = edge_collapse_count;
+
+				runSimplifyTasks(dispatch, context, rankEdgeCollapsesTask, job, edge_collapse_count);
+				sortEdgeCollapses(collapse_order, job, dispatch, context);
+			}
+			else
+			{
+				rankEdgeCollapses(edge_collapses, edge_collapse_count, vertex_positions, vertex_attributes, vertex_quadrics, attribute_quadrics, attribute_gradients, attribute_count, remap, wedge, vertex_kind, loop, loopback);
+				sortEdgeCollapses(collapse_order, edge_collapses, edge_collapse_count);
+			}
+
+			size_t triangle_collapse_goal = (result_count - target_index_count) / 3;
+
+			for (size_t i = 0; i < vertex_count; ++i)
+				collapse_remap[i] = unsigned(i);
+
+			memset(collapse_locked, 0, vertex_count);
+
+			size_t collapses = performEdgeCollapses(collapse_remap, collapse_locked, edge_collapses, edge_collapse_count, collapse_order, remap, wedge, vertex_kind, loop, loopback, vertex_positions, adjacency, triangle_collapse_goal, error_limit, result_error, collapse_log);
+
+			// no edges can be collapsed any more due to hitting the error limit or triangle collapse limit
+			if (collapses == 0)
+				break;
+
+			// each collapse moves all wedges of the source position; record them together so that any prefix of collapses is consistent
+			for (size_t i = 0; collapse_log && i < collapses; ++i)
+			{
+				const Collapse& c = edge_collapses[collapse_log[i]];
+				unsigned int r0 = remap[c.v0];
+
+				// collapse errors are only approximately sorted within a pass and may decrease between passes; keep recorded errors monotonic
+				collapse_log_error = collapse_log_error < c.error ? c.error : collapse_log_error;
+
+				unsigned int v = r0;
+				size_t group_start = collapse_log_count;
+
+				do
+				{
+					if (collapse_remap[v] != v)
+					{
+						meshopt_VertexCollapse& vc = out_collapses[collapse_log_count++];
+
+						vc.vertex = sparse_remap ? sparse_remap[v] : v;
+						vc.target = sparse_remap ? sparse_remap[collapse_remap[v]] : collapse_remap[v];
+						vc.error = sqrtf(collapse_log_error) * error_scale;
+					}
+
+					v = wedge[v];
+				} while (v != r0);
+
+				for (size_t j = group_start; j < collapse_log_count; ++j)
+					out_collapses[j].group = unsigned(collapse_log_count - j);
+			}
+
+			if (dispatch)
+				updateQuadrics(job, dispatch, context, vertex_error);
+			else
+				updateQuadrics(collapse_remap, vertex_count, vertex_quadrics, volume_gradients, attribute_quadrics, attribute_gradients, attribute_count, vertex_positions, remap, vertex_error);
+
+			// updateQuadrics will update vertex error if we use attributes, but if we don't then result_error and vertex_error are equivalent
+			vertex_error = attribute_count == 0 ? result_error : vertex_error;
+
+			// note: we update loops following edge collapses, but after this we might still have stale loop data
+			// this can happen when a triangle with a loop edge gets collapsed along a non-loop edge
+			// that works since a loop that points to a vertex that is no longer connected is not affecting collapse logic
+			remapEdgeLoops(loop, vertex_count, collapse_remap);
+			remapEdgeLoops(loopback, vertex_count, collapse_remap);
+
+			result_count = remapIndexBuffer(result, result_count, collapse_remap, remap);
+
+			if ((options & meshopt_SimplifyPrune) && result_count > target_index_count && component_nexterror <= vertex_error)
+				result_count = pruneComponents(result, result_count, components, component_errors, component_count, vertex_error, component_nexterror);
+		}
+
+		// at this point, component_nexterror might be stale: component it references may have been removed through a series of edge collapses
+		bool component_nextstale = true;
+
+		// we're done with the regular simplification but we're still short of the target; try pruning more aggressively towards error_limit
+		while ((options & meshopt_SimplifyPrune) && result_count > target_index_count && component_nexterror <= error_limit)
+		{
+#if TRACE
+			printf("pass %d: cleanup; ", int(pass_count++));
+#endif
+
+			float component_cutoff = component_nexterror * 1.5f < error_limit ? component_nexterror * 1.5f : error_limit;
+
+			// track maximum error in eligible components as we are increasing resulting error
+			float component_maxerror = 0;
+			for (size_t i = 0; i < component_count; ++i)
+				if (component_errors[i] > component_maxerror && component_errors[i] <= component_cutoff)
+					component_maxerror = component_errors[i];
+
+			size_t new_count = pruneComponents(result, result_count, components, component_errors, component_count, component_cutoff, component_nexterror);
+			if (new_count == result_count && !component_nextstale)
+				break;
+
+			component_nextstale = false; // pruneComponents guarantees next error is up to date
+			result_count = new_count;
+			result_error = result_error < component_maxerror ? component_maxerror : result_error;
+			vertex_error = vertex_error < component_maxerror ? component_maxerror : vertex_error;
+		}
+
+#if TRACE
+		printf("result: %d triangles, error: %e (pos %.3e); total %d passes\n", int(result_count / 3), sqrtf(result_error), sqrtf(vertex_error), int(pass_count));
+#endif
+
+		destination_counts[level] = result_count;
+
+		// result_error is quadratic; we need to remap it back to linear
+		if (out_result_errors)
+			out_result_errors[level] = sqrtf(result_error) * error_scale;
+
+		// convert resulting indices back into the dense space of the larger mesh; single level result is converted in place below
+		if (result != destinations[level])
+			for (size_t i = 0; i < result_count; ++i)
+				destinations[level][i] = sparse_remap ? sparse_remap[result[i]] : result[i];
+	}
+
+	if (out_collapse_count)
+		*out_collapse_count = collapse_log_count;
+
+	return result_count;
+}
+
+static void simplifyEdge(unsigned int* const* destinations, size_t* destination_counts, const unsigned int* indices, size_t index_count, const float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride, const float* vertex_attributes_data, size_t vertex_attributes_stride, const float* attribute_weights, size_t attribute_count, const unsigned char* vertex_lock, const size_t* target_index_counts, const float* target_errors, size_t level_count, unsigned int options, float* out_result_errors, meshopt_Dispatch dispatch, void* context, meshopt_VertexCollapse* out_collapses, size_t* out_collapse_count)
+{
+	assert(index_count % 3 == 0);
+	assert(vertex_positions_stride >= 12 && vertex_positions_stride <= 256);
+	assert(vertex_positions_stride % sizeof(float) == 0);
+	assert(level_count >= 1);
+	assert(level_count == 1 || (options & (meshopt_SimplifyInternalSolve | meshopt_SimplifyInternalDebug)) == 0);
+	assert(!out_collapses || (level_count == 1 && (options & meshopt_SimplifyPrune) == 0));
+	for (size_t i = 0; i < level_count; ++i)
+	{
+		assert(target_index_counts[i] <= (i == 0 ? index_count : target_index_counts[i - 1]));
+		assert(target_errors[i] >= (i == 0 ? 0 : target_errors[i - 1]));
+	}
+	assert(vertex_attributes_stride >= attribute_count * sizeof(float) && vertex_attributes_stride <= 256);
+	assert(vertex_attributes_stride % sizeof(float) == 0);
+	assert(attribute_count <= kMaxAttributes);
+	for (size_t i = 0; i < attribute_count; ++i)
+		assert(attribute_weights[i] >= 0);
+
+	meshopt_Allocator allocator;
+
+	// with multiple levels, simplification proceeds in a scratch buffer as destinations only receive the completed levels
+	unsigned int* result = level_count == 1 ? destinations[0] : allocator.allocate<unsigned int>(index_count);
+	if (result != indices)
+		memcpy(result, indices, index_count * sizeof(unsigned int));
+
+	unsigned int attribute_remap[kMaxAttributes];
+	size_t attributes_used = 0;
+
+	// remap attributes to only include ones with weight > 0 to minimize memory/compute overhead for quadrics
+	for (size_t i = 0; i < attribute_count; ++i)
+		if (attribute_weights[i] > 0)
+			attribute_remap[attributes_used++] = unsigned(i);
+
+	SimplifyMesh mesh = {};
+	EdgeAdjacency adjacency = {};
+	prepareSimplifyMesh(mesh, adjacency, result, index_count, vertex_positions_data, vertex_count, vertex_positions_stride, vertex_lock, options, (options & meshopt_SimplifyInternalSolve) && attributes_used, allocator);
+
+	vertex_count = mesh.vertex_count;
+
+	float* vertex_attributes = NULL;
+	Quadric* attribute_quadrics = NULL;
+	QuadricGrad* attribute_gradients = NULL;
+
+	if (attribute_count)
+	{
+		attribute_count = attributes_used;
+		vertex_attributes = allocator.allocate<float>(vertex_count * attribute_count);
+		rescaleAttributes(vertex_attributes, vertex_attributes_data, vertex_count, vertex_attributes_stride, attribute_weights, attribute_count, attribute_remap, mesh.sparse_remap);
+	}
+
+	if (attribute_count)
+	{
+		attribute_quadrics = allocator.allocate<Quadric>(vertex_count);
+		memset(attribute_quadrics, 0, vertex_count * sizeof(Quadric));
+
+		attribute_gradients = allocator.allocate<QuadricGrad>(vertex_count * attribute_count);
+		memset(attribute_gradients, 0, vertex_count * attribute_count * sizeof(QuadricGrad));
+
+		fillAttributeQuadrics(attribute_quadrics, attribute_gradients, result, index_count, mesh.vertex_positions, vertex_attributes, attribute_count);
+	}
+
+	size_t result_count = simplifyMesh(destinations, destination_counts, result, index_count, mesh, adjacency, vertex_attributes, attribute_quadrics, attribute_gradients, attribute_count, target_index_counts, target_errors, level_count, options, out_result_errors, dispatch, context, out_collapses, out_collapse_count);
+
+	unsigned int* sparse_remap = mesh.sparse_remap;
+	unsigned int* remap = mesh.remap;
+	unsigned char* vertex_kind = mesh.vertex_kind;
+	unsigned int* loop = mesh.loop;
+	unsigned int* loopback = mesh.loopback;
+
+	// if solve is requested, update input buffers destructively from internal data
+	if (options & meshopt_SimplifyInternalSolve)
+	{
+		unsigned char* vertex_update = allocator.allocate<unsigned char>(vertex_count);
+		memset(vertex_update, 0, vertex_count);
+
+		// limit quadric solve to vertices that are still used in the result
+		for (size_t i = 0; i < result_count; ++i)
+		{
+			unsigned int v = result[i];
+
+			// mark the vertex for finalizeVertices and root vertex for solve*
+			vertex_update[remap[v]] = vertex_update[v] = 1;
+		}
+
+		// edge adjacency may be stale as we haven't updated it after last series of edge collapses
+		updateEdgeAdjacency(adjacency, result, result_count, vertex_count, remap);
+
+		solvePositions(mesh.vertex_positions, vertex_count, mesh.vertex_quadrics, mesh.volume_gradients, attribute_quadrics, attribute_gradients, attribute_count, remap, mesh.wedge, adjacency, vertex_kind, vertex_update);
+
+		if (attribute_count)
+			solveAttributes(mesh.vertex_positions, vertex_attributes, vertex_count, attribute_quadrics, attribute_gradients, attribute_count, remap, mesh.wedge, vertex_kind, vertex_update);
+
+		finalizeVertices(const_cast<float*>(vertex_positions_data), vertex_positions_stride, const_cast<float*>(vertex_attributes_data), vertex_attributes_stride, attribute_weights, attribute_count, vertex_count, mesh.vertex_positions, vertex_attributes, sparse_remap, attribute_remap, mesh.vertex_scale, mesh.vertex_offset, vertex_kind, vertex_update, vertex_lock);
+	}
+
+	// if debug visualization data is requested, fill it instead of index data; for simplicity, this doesn't work with sparsity
+	if ((options & meshopt_SimplifyInternalDebug) && !sparse_remap)
+	{
+		assert(Kind_Count <= 8 && vertex_count < (1 << 28)); // 3 bit kind, 1 bit loop
+
+		for (size_t i = 0; i < result_count; i += 3)
+		{
+			unsigned int a = result[i + 0], b = result[i + 1], c = result[i + 2];
+
+			result[i + 0] |= (vertex_kind[a] << 28) | (unsigned(loop[a] == b || loopback[b] == a) << 31);
+			result[i + 1] |= (vertex_kind[b] << 28) | (unsigned(loop[b] == c || loopback[c] == b) << 31);
+			result[i + 2] |= (vertex_kind[c] << 28) | (unsigned(loop[c] == a || loopback[a] == c) << 31);
+		}
+	}
+
+	// convert resulting indices back into the dense space of the larger mesh
+	if (sparse_remap && level_count == 1)
+		for (size_t i = 0; i < result_count; ++i)
+			result[i] = sparse_remap[result[i]];
+}
+
+struct SimplifyBatchJob
+{
+	const meshopt_SimplifyBatchMesh* meshes;
+	const size_t* task_offsets;
+	unsigned int options;
+
+	size_t* result_counts;
+	float* result_errors;
+};
+
+static void simplifyBatchTask(void* context, size_t index)
+{
+	const SimplifyBatchJob& job = *static_cast<SimplifyBatchJob*>(context);
+
+	for (size_t i = job.task_offsets[index]; i < job.task_offsets[index + 1]; ++i)
+	{
+		const meshopt_SimplifyBatchMesh& mesh = job.meshes[i];
+		unsigned int* destination = mesh.destination;
+		float result_error = 0;
+
+		simplifyEdge(&destination, &job.result_counts[i], mesh.indices, mesh.index_count, mesh.vertex_positions, mesh.vertex_count, mesh.vertex_positions_stride, mesh.vertex_attributes, mesh.vertex_attributes_stride, mesh.attribute_weights, mesh.attribute_count, mesh.vertex_lock, &mesh.target_index_count, &mesh.target_error, 1, job.options, &result_error, NULL, NULL, NULL, NULL);
+
+		if (job.result_errors)
+			job.result_errors[i] = result_error;
+	}
+}
+
+// returns the upper bound of the memory allocated by simplifyEdge for a single level without Internal options
+static size_t getSimplifyMemory(size_t index_count, size_t vertex_count, size_t attribute_count, unsigned int options)
+{
+	// adjacency, edge collapses and collapse order; collapse capacity is bounded by index count plus padding
+	size_t result = index_count * sizeof(EdgeAdjacency::Edge) + (index_count + 3) * (sizeof(Collapse) + sizeof(unsigned int));
+
+	// adjacency offsets, remap, wedge, loop, loopback, collapse remap; vertex kind, collapse locked
+	result += (vertex_count + 1) * sizeof(unsigned int) + vertex_count * sizeof(unsigned int) * 5 + vertex_count * 2;
+	result += vertex_count * (sizeof(Vector3) + sizeof(Quadric));
+
+	if (attribute_count)
+		result += vertex_count * (sizeof(Quadric) + attribute_count * (sizeof(float) + sizeof(QuadricGrad)));
+
+	// sparse remap and filter bit set
+	if (options & meshopt_SimplifySparse)
+		result += vertex_count * sizeof(unsigned int) + (vertex_count + 7) / 8;
+
+	// components and component errors
+	if (options & meshopt_SimplifyPrune)
+		result += vertex_count * (sizeof(unsigned int) + sizeof(float) * 4);
+
+	return result;
+}
+
+static size_t alignContextSize(size_t size)
+{
+	return (size + 15) & ~size_t(15);
+}
+
+template <typename T>
+static T* copyContextData(unsigned char*& data, const T* source, size_t count)
+{
+	if (!source)
+		return NULL;
+
+	T* result = reinterpret_cast<T*>(data);
+	memcpy(result, source, count * sizeof(T));
+	data += alignContextSize(count * sizeof(T));
+
+	return result;
+}
+
+} // namespace meshopt
+
+size_t meshopt_simplifyEdge(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride, const float* vertex_attributes_data, size_t vertex_attributes_stride, const float* attribute_weights, size_t attribute_count, const unsigned char* vertex_lock, size_t target_index_count, float target_error, unsigned int options, float* out_result_error)
+{
+	size_t result_count = 0;
+	float result_error = 0;
+
+	meshopt::simplifyEdge(&destination, &result_count, indices, index_count, vertex_positions_data, vertex_count, vertex_positions_stride, vertex_attributes_data, vertex_attributes_stride, attribute_weights, attribute_count, vertex_lock, &target_index_count, &target_error, 1, options, &result_error, NULL, NULL, NULL, NULL);
+
+	if (out_result_error)
+		*out_result_error = result_error;
+
+	return result_count;
+}
+
+size_t meshopt_simplifyLevels(unsigned int* const* destinations, size_t* destination_counts, const unsigned int* indices, size_t index_count, const float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride, const float* vertex_attributes_data, size_t vertex_attributes_stride, const float* attribute_weights, size_t attribute_count, const unsigned char* vertex_lock, const size_t* target_index_counts, const float* target_errors, size_t level_count, unsigned int options, float* out_result_errors)
+{
+	if (level_count == 0)
+		return 0;
+
+	meshopt::simplifyEdge(destinations, destination_counts, indices, index_count, vertex_positions_data, vertex_count, vertex_positions_stride, vertex_attributes_data, vertex_attributes_stride, attribute_weights, attribute_count, vertex_lock, target_index_counts, target_errors, level_count, options, out_result_errors, NULL, NULL, NULL, NULL);
+
+	return destination_counts[level_count - 1];
+}
+
+size_t meshopt_simplify(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride, size_t target_index_count, float target_error, unsigned int options, float* out_result_error)
+{
+	assert((options & meshopt_SimplifyInternalSolve) == 0); // use meshopt_simplifyWithUpdate instead
+
+	return meshopt_simplifyEdge(destination, indices, index_count, vertex_positions_data, vertex_count, vertex_positions_stride, NULL, 0, NULL, 0, NULL, target_index_count, target_error, options, out_result_error);
+}
+
+size_t meshopt_simplifyWithAttributes(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride, const float* vertex_attributes_data, size_t vertex_attributes_stride, const float* attribute_weights, size_t attribute_count, const unsigned char* vertex_lock, size_t target_index_count, float target_error, unsigned int options, float* out_result_error)
+{
+	assert((options & meshopt_SimplifyInternalSolve) == 0); // use meshopt_simplifyWithUpdate instead
+
+	return meshopt_simplifyEdge(destination, indices, index_count, vertex_positions_data, vertex_count, vertex_positions_stride, vertex_attributes_data, vertex_attributes_stride, attribute_weights, attribute_count, vertex_lock, target_index_count, target_error, options, out_result_error);
+}
+
+size_t meshopt_simplifyWithUpdate(unsigned int* indices, size_t index_count, float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride, float* vertex_attributes_data, size_t vertex_attributes_stride, const float* attribute_weights, size_t attribute_count, const unsigned char* vertex_lock, size_t target_index_count, float target_error, unsigned int options, float* out_result_error)
+{
+	return meshopt_simplifyEdge(indices, indices, index_count, vertex_positions_data, vertex_count, vertex_positions_stride, vertex_attributes_data, vertex_attributes_stride, attribute_weights, attribute_count, vertex_lock, target_index_count, target_error, options | meshopt_SimplifyInternalSolve, out_result_error);
+}
+
+size_t meshopt_simplifyParallel(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride, const float* vertex_attributes_data, size_t vertex_attributes_stride, const float* attribute_weights, size_t attribute_count, const unsigned char* vertex_lock, size_t target_index_count, float target_error, unsigned int options, float* out_result_error, meshopt_Dispatch dispatch, void* context)
+{
+	assert((options & (meshopt_SimplifyInternalSolve | meshopt_SimplifyInternalDebug)) == 0);
+
+	size_t result_count = 0;
+	float result_error = 0;
+
+	meshopt::simplifyEdge(&destination, &result_count, indices, index_count, vertex_positions_data, vertex_count, vertex_positions_stride, vertex_attributes_data, vertex_attributes_stride, attribute_weights, attribute_count, vertex_lock, &target_index_count, &target_error, 1, options, &result_error, dispatch, context, NULL, NULL);
+
+	if (out_result_error)
+		*out_result_error = result_error;
+
+	return result_count;
+}
+
+size_t meshopt_simplifyTiled(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride, const float* vertex_attributes_data, size_t vertex_attributes_stride, const float* attribute_weights, size_t attribute_count, const unsigned char* vertex_lock, size_t target_index_count, float target_error, unsigned int options, size_t max_tile_triangles, float* out_result_error)
+{
+	using namespace meshopt;
+
+	assert(index_count % 3 == 0);
+	assert(vertex_positions_stride >= 12 && vertex_positions_stride <= 256);
+	assert(vertex_positions_stride % sizeof(float) == 0);
+	assert(target_index_count <= index_count);
+	assert(max_tile_triangles > 0);
+	assert((options & (meshopt_SimplifyInternalSolve | meshopt_SimplifyInternalDebug)) == 0);
+
+	meshopt_Allocator allocator;
+
+	size_t vertex_stride_float = vertex_positions_stride / sizeof(float);
+
+	// tiles are simplified with an absolute error so that the error limit is consistent across tiles with different extents
+	float error_scale = (options & meshopt_SimplifyErrorAbsolute) ? 1.f : meshopt_simplifyScale(vertex_positions_data, vertex_count, vertex_positions_stride);
+	error_scale = error_scale > 0 ? error_scale : 1.f;
+	unsigned int tile_options = options | meshopt_SimplifySparse | meshopt_SimplifyErrorAbsolute;
+
+	// vertices with positions that are shared between tiles are locked to keep tile boundaries consistent; this is the only state that scales with the input size
+	// sharing is tracked per position so that seam vertices and unwelded copies on tile boundaries are locked together
+	unsigned char* tile_lock = allocator.allocate<unsigned char>(vertex_count);
+	unsigned int* position_tile = allocator.allocate<unsigned int>(vertex_count);
+	unsigned int* position_remap = allocator.allocate<unsigned int>(vertex_count);
+
+	meshopt_generatePositionRemap(position_remap, vertex_positions_data, vertex_count, vertex_positions_stride);
+
+	// median splits produce tiles with more than max_tile_triangles/2 triangles, which bounds the tile count
+	size_t max_tiles = (index_count / 3 + max_tile_triangles - 1) / max_tile_triangles * 2 + 1;
+	size_t* tile_offsets = allocator.allocate<size_t>(max_tiles + 1);
+
+	if (destination != indices)
+		memcpy(destination, indices, index_count * sizeof(unsigned int));
+
 	size_t result_count = index_count;
 	float result_error = 0;
-	float vertex_error = 0;
 
-	// target_error input is linear; we need to adjust it to match quadricError units
-	float error_scale = (options & meshopt_SimplifyErrorAbsolute) ? vertex_scale : 1.f;
-	float error_limit = (target_error * target_error) / (error_scale * error_scale);
+	// each pass partitions the current result into tiles and simplifies each tile independently while keeping tile boundaries locked
+	// subsequent passes have fewer triangles per unit of area, so tile boundaries move and the previously locked seams get simplified
+	while (result_count > target_index_count)
+	{
+		size_t triangle_count = result_count / 3;
+
+		size_t tile_count = 0;
+		partitionTiles(tile_offsets, tile_count, destination, 0, triangle_count, vertex_positions_data, vertex_stride_float, max_tile_triangles);
+		assert(tile_count <= max_tiles);
+
+		tile_offsets[tile_count] = triangle_count;
+
+		if (vertex_lock)
+			memcpy(tile_lock, vertex_lock, vertex_count);
+		else
+			memset(tile_lock, 0, vertex_count);
+
+		// position_tile is ~0u for unused positions, and ~1u for positions used by more than one tile
+		memset(position_tile, -1, vertex_count * sizeof(unsigned int));
+
+		for (size_t i = 0; i < tile_count; ++i)
+			for (size_t j = tile_offsets[i] * 3; j < tile_offsets[i + 1] * 3; ++j)
+			{
+				unsigned int p = position_remap[destination[j]];
+
+				position_tile[p] = (position_tile[p] == ~0u || position_tile[p] == i) ? unsigned(i) : ~1u;
+			}
+
+		for (size_t i = 0; i < vertex_count; ++i)
+			if (position_tile[position_remap[i]] == ~1u)
+				tile_lock[i] |= meshopt_SimplifyVertex_Lock;
+
+		size_t write = 0;
+
+		for (size_t i = 0; i < tile_count; ++i)
+		{
+			unsigned int* tile = destination + tile_offsets[i] * 3;
+			size_t tile_index_count = (tile_offsets[i + 1] - tile_offsets[i]) * 3;
+
+			// distribute the remaining reduction across tiles proportionally to their size
+			size_t tile_target = size_t(double(tile_index_count) * double(target_index_count) / double(result_count)) / 3 * 3;
+
+			float tile_error = 0;
+			size_t tile_result = meshopt_simplifyWithAttributes(tile, tile, tile_index_count, vertex_positions_data, vertex_count, vertex_positions_stride, vertex_attributes_data, vertex_attributes_stride, attribute_weights, attribute_count, tile_lock, tile_target, target_error * error_scale, tile_options, &tile_error);
+
+			// tiles are compacted in order, so the output never overlaps unprocessed tiles
+			memmove(destination + write, tile, tile_result * sizeof(unsigned int));
+			write += tile_result;
+
+			result_error = result_error < tile_error ? tile_error : result_error;
+		}
+
+		// stop when a single tile covered the entire mesh or when the seams can't be simplified further
+		bool done = tile_count == 1 || (result_count - write) * 100 < result_count;
+
+		result_count = write;
+
+		if (done)
+			break;
+	}
+
+	if (out_result_error)
+		*out_result_error = result_error / error_scale;
+
+	return result_count;
+}
+
+size_t meshopt_simplifyProgressive(meshopt_VertexCollapse* collapses, const unsigned int* indices, size_t index_count, const float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride, const float* vertex_attributes_data, size_t vertex_attributes_stride, const float* attribute_weights, size_t attribute_count, const unsigned char* vertex_lock, size_t target_index_count, float target_error, unsigned int options, float* out_result_error)
+{
+	assert((options & (meshopt_SimplifyPrune | meshopt_SimplifyInternalSolve | meshopt_SimplifyInternalDebug)) == 0);
+
+	meshopt_Allocator allocator;
+
+	unsigned int* result = allocator.allocate<unsigned int>(index_count);
+
+	size_t result_count = 0;
+	float result_error = 0;
+	size_t collapse_count = 0;
+
+	meshopt::simplifyEdge(&result, &result_count, indices, index_count, vertex_positions_data, vertex_count, vertex_positions_stride, vertex_attributes_data, vertex_attributes_stride, attribute_weights, attribute_count, vertex_lock, &target_index_count, &target_error, 1, options, &result_error, NULL, NULL, collapses, &collapse_count);
 
-	while (result_count > target_index_count)
-	{
-		// note: throughout the simplification process adjacency structure reflects welded topology for result-in-progress
-		updateEdgeAdjacency(adjacency, result, result_count, vertex_count, remap);
+	if (out_result_error)
+		*out_result_error = result_error;
 
-		size_t edge_collapse_count = pickEdgeCollapses(edge_collapses, collapse_capacity, result, result_count, remap, vertex_kind, loop, loopback);
-		assert(edge_collapse_count <= collapse_capacity);
+	return collapse_count;
+}
 
-		// no edges can be collapsed any more due to topology restrictions
-		if (edge_collapse_count == 0)
-			break;
+size_t meshopt_generateProgressiveIndices(unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count, const meshopt_VertexCollapse* collapses, size_t collapse_count)
+{
+	assert(index_count % 3 == 0);
 
-#if TRACE
-		printf("pass %d:%c", int(pass_count++), TRACE >= 2 ? '\n' : ' ');
-#endif
+	meshopt_Allocator allocator;
 
-		rankEdgeCollapses(edge_collapses, edge_collapse_count, vertex_positions, vertex_attributes, vertex_quadrics, attribute_quadrics, attribute_gradients, attribute_count, remap, wedge, vertex_kind, loop, loopback);
+	unsigned int* remap = allocator.allocate<unsigned int>(vertex_count);
 
-		sortEdgeCollapses(collapse_order, edge_collapses, edge_collapse_count);
+	for (size_t i = 0; i < vertex_count; ++i)
+		remap[i] = unsigned(i);
 
-		size_t triangle_collapse_goal = (result_count - target_index_count) / 3;
+	// removed vertices never become collapse targets later, so processing collapses in reverse order resolves collapse chains in one pass
+	for (size_t i = collapse_count; i > 0; --i)
+	{
+		const meshopt_VertexCollapse& c = collapses[i - 1];
+		assert(c.vertex < vertex_count && c.target < vertex_count);
 
-		for (size_t i = 0; i < vertex_count; ++i)
-			collapse_remap[i] = unsigned(i);
+		remap[c.vertex] = remap[c.target];
+	}
 
-		memset(collapse_locked, 0, vertex_count);
+	size_t write = 0;
 
-		size_t collapses = performEdgeCollapses(collapse_remap, collapse_locked, edge_collapses, edge_collapse_count, collapse_order, remap, wedge, vertex_kind, loop, loopback, vertex_positions, adjacency, triangle_collapse_goal, error_limit, result_error);
+	for (size_t i = 0; i < index_count; i += 3)
+	{
+		unsigned int a = remap[indices[i + 0]], b = remap[indices[i + 1]], c = remap[indices[i + 2]];
 
-		// no edges can be collapsed any more due to hitting the error limit or triangle collapse limit
-		if (collapses == 0)
-			break;
+		if (a != b && a != c && b != c)
+		{
+			destination[write + 0] = a;
+			destination[write + 1] = b;
+			destination[write + 2] = c;
+			write += 3;
+		}
+	}
 
-		updateQuadrics(collapse_remap, vertex_count, vertex_quadrics, volume_gradients, attribute_quadrics, attribute_gradients, attribute_count, vertex_positions, remap, vertex_error);
+	return write;
+}
 
-		// updateQuadrics will update vertex error if we use attributes, but if we don't then result_error and vertex_error are equivalent
-		vertex_error = attribute_count == 0 ? result_error : vertex_error;
+struct meshopt_SimplifyContext
+{
+	meshopt::SimplifyMesh mesh;
 
-		// note: we update loops following edge collapses, but after this we might still have stale loop data
-		// this can happen when a triangle with a loop edge gets collapsed along a non-loop edge
-		// that works since a loop that points to a vertex that is no longer connected is not affecting collapse logic
-		remapEdgeLoops(loop, vertex_count, collapse_remap);
-		remapEdgeLoops(loopback, vertex_count, collapse_remap);
+	unsigned int* indices;
+	size_t index_count;
 
-		result_count = remapIndexBuffer(result, result_count, collapse_remap, remap);
+	float* vertex_attributes;
+	size_t attribute_count;
 
-		if ((options & meshopt_SimplifyPrune) && result_count > target_index_count && component_nexterror <= vertex_error)
-			result_count = pruneComponents(result, result_count, components, component_errors, component_count, vertex_error, component_nexterror);
-	}
+	unsigned int options;
+};
 
-	// at this point, component_nexterror might be stale: component it references may have been removed through a series of edge collapses
-	bool component_nextstale = true;
+meshopt_SimplifyContext* meshopt_simplifyContextCreate(const unsigned int* indices, size_t index_count, const float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride, const float* vertex_attributes_data, size_t vertex_attributes_stride, size_t attribute_count, const unsigned char* vertex_lock, unsigned int options)
+{
+	using namespace meshopt;
 
-	// we're done with the regular simplification but we're still short of the target; try pruning more aggressively towards error_limit
-	while ((options & meshopt_SimplifyPrune) && result_count > target_index_count && component_nexterror <= error_limit)
-	{
-#if TRACE
-		printf("pass %d: cleanup; ", int(pass_count++));
-#endif
+	assert(index_count % 3 == 0);
+	assert(vertex_positions_stride >= 12 && vertex_positions_stride <= 256);
+	assert(vertex_positions_stride % sizeof(float) == 0);
+	assert(vertex_attributes_stride >= attribute_count * sizeof(float) && vertex_attributes_stride <= 256);
+	assert(vertex_attributes_stride % sizeof(float) == 0);
+	assert(attribute_count <= kMaxAttributes);
+	assert((options & (meshopt_SimplifyInternalSolve | meshopt_SimplifyInternalDebug)) == 0);
 
-		float component_cutoff = component_nexterror * 1.5f < error_limit ? component_nexterror * 1.5f : error_limit;
+	meshopt_Allocator allocator;
 
-		// track maximum error in eligible components as we are increasing resulting error
-		float component_maxerror = 0;
-		for (size_t i = 0; i < component_count; ++i)
-			if (component_errors[i] > component_maxerror && component_errors[i] <= component_cutoff)
-				component_maxerror = component_errors[i];
+	unsigned int* result = allocator.allocate<unsigned int>(index_count);
+	memcpy(result, indices, index_count * sizeof(unsigned int));
 
-		size_t new_count = pruneComponents(result, result_count, components, component_errors, component_count, component_cutoff, component_nexterror);
-		if (new_count == result_count && !component_nextstale)
-			break;
+	SimplifyMesh mesh = {};
+	EdgeAdjacency adjacency = {};
+	prepareSimplifyMesh(mesh, adjacency, result, index_count, vertex_positions_data, vertex_count, vertex_positions_stride, vertex_lock, options, false, allocator);
 
-		component_nextstale = false; // pruneComponents guarantees next error is up to date
-		result_count = new_count;
-		result_error = result_error < component_maxerror ? component_maxerror : result_error;
-		vertex_error = vertex_error < component_maxerror ? component_maxerror : vertex_error;
-	}
+	vertex_count = mesh.vertex_count;
 
-#if TRACE
-	printf("result: %d triangles, error: %e (pos %.3e); total %d passes\n", int(result_count / 3), sqrtf(result_error), sqrtf(vertex_error), int(pass_count));
-#endif
+	// attributes are stored without weights in sparse space, so that each run only needs to rescale them
+	float* vertex_attributes = NULL;
 
-	// if solve is requested, update input buffers destructively from internal data
-	if (options & meshopt_SimplifyInternalSolve)
+	if (attribute_count)
 	{
-		unsigned char* vertex_update = collapse_locked; // reuse as scratch space
-		memset(vertex_update, 0, vertex_count);
+		size_t vertex_attributes_stride_float = vertex_attributes_stride / sizeof(float);
 
-		// limit quadric solve to vertices that are still used in the result
-		for (size_t i = 0; i < result_count; ++i)
+		vertex_attributes = allocator.allocate<float>(vertex_count * attribute_count);
+
+		for (size_t i = 0; i < vertex_count; ++i)
 		{
-			unsigned int v = result[i];
+			unsigned int ri = mesh.sparse_remap ? mesh.sparse_remap[i] : unsigned(i);
 
-			// mark the vertex for finalizeVertices and root vertex for solve*
-			vertex_update[remap[v]] = vertex_update[v] = 1;
+			memcpy(vertex_attributes + i * attribute_count, vertex_attributes_data + ri * vertex_attributes_stride_float, attribute_count * sizeof(float));
 		}
+	}
 
-		// edge adjacency may be stale as we haven't updated it after last series of edge collapses
-		updateEdgeAdjacency(adjacency, result, result_count, vertex_count, remap);
+	// all persistent data is packed into a single allocation; intermediate data like adjacency is discarded
+	size_t context_size = alignContextSize(sizeof(meshopt_SimplifyContext));
+	context_size += alignContextSize(index_count * sizeof(unsigned int));
+	context_size += mesh.sparse_remap ? alignContextSize(vertex_count * sizeof(unsigned int)) : 0;
+	context_size += alignContextSize(vertex_count * sizeof(unsigned int)) * 4; // remap, wedge, loop, loopback
+	context_size += alignContextSize(vertex_count * sizeof(unsigned char));
+	context_size += alignContextSize(vertex_count * sizeof(Vector3));
+	context_size += alignContextSize(vertex_count * sizeof(Quadric));
+	context_size += alignContextSize(vertex_count * attribute_count * sizeof(float));
+
+	unsigned char* data = static_cast<unsigned char*>(meshopt_Allocator::storage().allocate(context_size));
+
+	meshopt_SimplifyContext* context = reinterpret_cast<meshopt_SimplifyContext*>(data);
+	data += alignContextSize(sizeof(meshopt_SimplifyContext));
+
+	context->mesh = mesh;
+	context->mesh.sparse_remap = copyContextData(data, mesh.sparse_remap, vertex_count);
+	context->mesh.remap = copyContextData(data, mesh.remap, vertex_count);
+	context->mesh.wedge = copyContextData(data, mesh.wedge, vertex_count);
+	context->mesh.vertex_kind = copyContextData(data, mesh.vertex_kind, vertex_count);
+	context->mesh.loop = copyContextData(data, mesh.loop, vertex_count);
+	context->mesh.loopback = copyContextData(data, mesh.loopback, vertex_count);
+	context->mesh.vertex_positions = copyContextData(data, mesh.vertex_positions, vertex_count);
+	context->mesh.vertex_quadrics = copyContextData(data, mesh.vertex_quadrics, vertex_count);
+	context->indices = copyContextData(data, result, index_count);
+	context->index_count = index_count;
+	context->vertex_attributes = copyContextData(data, vertex_attributes, vertex_count * attribute_count);
+	context->attribute_count = attribute_count;
+	context->options = options;
+
+	assert(data <= reinterpret_cast<unsigned char*>(context) + context_size);
+
+	return context;
+}
 
-		solvePositions(vertex_positions, vertex_count, vertex_quadrics, volume_gradients, attribute_quadrics, attribute_gradients, attribute_count, remap, wedge, adjacency, vertex_kind, vertex_update);
+void meshopt_simplifyContextDestroy(meshopt_SimplifyContext* context)
+{
+	meshopt_Allocator::storage().deallocate(context);
+}
 
-		if (attribute_count)
-			solveAttributes(vertex_positions, vertex_attributes, vertex_count, attribute_quadrics, attribute_gradients, attribute_count, remap, wedge, vertex_kind, vertex_update);
+size_t meshopt_simplifyWithContext(unsigned int* destination, const meshopt_SimplifyContext* context, const float* attribute_weights, size_t target_index_count, float target_error, float* out_result_error)
+{
+	using namespace meshopt;
+
+	size_t index_count = context->index_count;
+	size_t vertex_count = context->mesh.vertex_count;
+	size_t attribute_count = context->attribute_count;
+
+	assert(target_index_count <= index_count);
+	assert(target_error >= 0);
+	for (size_t i = 0; i < attribute_count; ++i)
+		assert(attribute_weights[i] >= 0);
+
+	meshopt_Allocator allocator;
+
+	memcpy(destination, context->indices, index_count * sizeof(unsigned int));
+
+	// edge collapses update vertex quadrics and edge loops in place, so each run works on its own copy of them
+	SimplifyMesh mesh = context->mesh;
+
+	mesh.loop = allocator.allocate<unsigned int>(vertex_count);
+	memcpy(mesh.loop, context->mesh.loop, vertex_count * sizeof(unsigned int));
+
+	mesh.loopback = allocator.allocate<unsigned int>(vertex_count);
+	memcpy(mesh.loopback, context->mesh.loopback, vertex_count * sizeof(unsigned int));
+
+	mesh.vertex_quadrics = allocator.allocate<Quadric>(vertex_count);
+	memcpy(mesh.vertex_quadrics, context->mesh.vertex_quadrics, vertex_count * sizeof(Quadric));
+
+	EdgeAdjacency adjacency = {};
+	prepareEdgeAdjacency(adjacency, index_count, vertex_count, allocator);
+	updateEdgeAdjacency(adjacency, destination, index_count, vertex_count, NULL);
+
+	float* vertex_attributes = NULL;
+	Quadric* attribute_quadrics = NULL;
+	QuadricGrad* attribute_gradients = NULL;
+
+	if (attribute_count)
+	{
+		// remap attributes to only include ones with weight > 0 to minimize memory/compute overhead for quadrics
+		unsigned int attribute_remap[kMaxAttributes];
+		size_t attributes_used = 0;
+
+		for (size_t i = 0; i < attribute_count; ++i)
+			if (attribute_weights[i] > 0)
+				attribute_remap[attributes_used++] = unsigned(i);
+
+		vertex_attributes = allocator.allocate<float>(vertex_count * attributes_used);
+		rescaleAttributes(vertex_attributes, context->vertex_attributes, vertex_count, attribute_count * sizeof(float), attribute_weights, attributes_used, attribute_remap, NULL);
 
-		finalizeVertices(const_cast<float*>(vertex_positions_data), vertex_positions_stride, const_cast<float*>(vertex_attributes_data), vertex_attributes_stride, attribute_weights, attribute_count, vertex_count, vertex_positions, vertex_attributes, sparse_remap, attribute_remap, vertex_scale, vertex_offset, vertex_kind, vertex_update, vertex_lock);
+		attribute_count = attributes_used;
 	}
 
-	// if debug visualization data is requested, fill it instead of index data; for simplicity, this doesn't work with sparsity
-	if ((options & meshopt_SimplifyInternalDebug) && !sparse_remap)
+	if (attribute_count)
 	{
-		assert(Kind_Count <= 8 && vertex_count < (1 << 28)); // 3 bit kind, 1 bit loop
+		attribute_quadrics = allocator.allocate<Quadric>(vertex_count);
+		memset(attribute_quadrics, 0, vertex_count * sizeof(Quadric));
 
-		for (size_t i = 0; i < result_count; i += 3)
-		{
-			unsigned int a = result[i + 0], b = result[i + 1], c = result[i + 2];
+		attribute_gradients = allocator.allocate<QuadricGrad>(vertex_count * attribute_count);
+		memset(attribute_gradients, 0, vertex_count * attribute_count * sizeof(QuadricGrad));
 
-			result[i + 0] |= (vertex_kind[a] << 28) | (unsigned(loop[a] == b || loopback[b] == a) << 31);
-			result[i + 1] |= (vertex_kind[b] << 28) | (unsigned(loop[b] == c || loopback[c] == b) << 31);
-			result[i + 2] |= (vertex_kind[c] << 28) | (unsigned(loop[c] == a || loopback[a] == c) << 31);
-		}
+		fillAttributeQuadrics(attribute_quadrics, attribute_gradients, destination, index_count, mesh.vertex_positions, vertex_attributes, attribute_count);
 	}
 
+	size_t result_count = 0;
+	float result_error = 0;
+
+	simplifyMesh(&destination, &result_count, destination, index_count, mesh, adjacency, vertex_attributes, attribute_quadrics, attribute_gradients, attribute_count, &target_index_count, &target_error, 1, context->options, &result_error, NULL, NULL, NULL, NULL);
+
 	// convert resulting indices back into the dense space of the larger mesh
-	if (sparse_remap)
+	if (mesh.sparse_remap)
 		for (size_t i = 0; i < result_count; ++i)
-			result[i] = sparse_remap[result[i]];
+			destination[i] = mesh.sparse_remap[destination[i]];
 
-	// result_error is quadratic; we need to remap it back to linear
 	if (out_result_error)
-		*out_result_error = sqrtf(result_error) * error_scale;
+		*out_result_error = result_error;
 
 	return result_count;
 }
 
-size_t meshopt_simplify(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride, size_t target_index_count, float target_error, unsigned int options, float* out_result_error)
+size_t meshopt_simplifyWithBudget(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride, const float* vertex_attributes_data, size_t vertex_attributes_stride, const float* attribute_weights, size_t attribute_count, const unsigned char* vertex_lock, size_t target_index_count, float target_error, unsigned int options, size_t memory_budget, float* out_result_error, size_t* out_result_memory)
 {
-	assert((options & meshopt_SimplifyInternalSolve) == 0); // use meshopt_simplifyWithUpdate instead
+	using namespace meshopt;
 
-	return meshopt_simplifyEdge(destination, indices, index_count, vertex_positions_data, vertex_count, vertex_positions_stride, NULL, 0, NULL, 0, NULL, target_index_count, target_error, options, out_result_error);
-}
+	assert(vertex_attributes_stride >= attribute_count * sizeof(float) && vertex_attributes_stride <= 256);
+	assert(vertex_attributes_stride % sizeof(float) == 0);
+	assert(attribute_count <= kMaxAttributes);
+	assert((options & (meshopt_SimplifyInternalSolve | meshopt_SimplifyInternalDebug)) == 0);
 
-size_t meshopt_simplifyWithAttributes(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride, const float* vertex_attributes_data, size_t vertex_attributes_stride, const float* attribute_weights, size_t attribute_count, const unsigned char* vertex_lock, size_t target_index_count, float target_error, unsigned int options, float* out_result_error)
-{
-	assert((options & meshopt_SimplifyInternalSolve) == 0); // use meshopt_simplifyWithUpdate instead
+	unsigned int attribute_remap[kMaxAttributes];
+	size_t attributes_used = 0;
 
-	return meshopt_simplifyEdge(destination, indices, index_count, vertex_positions_data, vertex_count, vertex_positions_stride, vertex_attributes_data, vertex_attributes_stride, attribute_weights, attribute_count, vertex_lock, target_index_count, target_error, options, out_result_error);
+	for (size_t i = 0; i < attribute_count; ++i)
+		if (attribute_weights[i] > 0)
+			attribute_remap[attributes_used++] = unsigned(i);
+
+	// pick the largest number of components that fits; compressed attributes need an extra copy that the simplifier rescales internally
+	size_t component_count = attributes_used;
+
+	while (component_count > 0 && getSimplifyMemory(index_count, vertex_count, component_count, options) + (component_count < attributes_used ? vertex_count * component_count * sizeof(float) : 0) > memory_budget)
+		component_count--;
+
+	size_t result_memory = getSimplifyMemory(index_count, vertex_count, component_count, options);
+	size_t result_count = 0;
+	float result_error = 0;
+
+	if (component_count == attributes_used)
+	{
+		// all attributes fit, no compression is necessary
+		meshopt::simplifyEdge(&destination, &result_count, indices, index_count, vertex_positions_data, vertex_count, vertex_positions_stride, vertex_attributes_data, vertex_attributes_stride, attribute_weights, attribute_count, vertex_lock, &target_index_count, &target_error, 1, options, &result_error, NULL, NULL, NULL, NULL);
+	}
+	else
+	{
+		meshopt_Allocator allocator;
+
+		float* components = component_count ? allocator.allocate<float>(vertex_count * component_count) : NULL;
+		float component_weights[kMaxAttributes];
+
+		if (component_count)
+			compressAttributes(components, component_count, vertex_attributes_data, vertex_count, vertex_attributes_stride, attribute_weights, attribute_remap, attributes_used);
+
+		// components are already weighted
+		for (size_t i = 0; i < component_count; ++i)
+			component_weights[i] = 1.f;
+
+		meshopt::simplifyEdge(&destination, &result_count, indices, index_count, vertex_positions_data, vertex_count, vertex_positions_stride, components, component_count * sizeof(float), component_weights, component_count, vertex_lock, &target_index_count, &target_error, 1, options, &result_error, NULL, NULL, NULL, NULL);
+
+		result_memory += vertex_count * component_count * sizeof(float);
+	}
+
+	if (out_result_error)
+		*out_result_error = result_error;
+
+	if (out_result_memory)
+		*out_result_memory = result_memory;
+
+	return result_count;
 }
 
-size_t meshopt_simplifyWithUpdate(unsigned int* indices, size_t index_count, float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride, float* vertex_attributes_data, size_t vertex_attributes_stride, const float* attribute_weights, size_t attribute_count, const unsigned char* vertex_lock, size_t target_index_count, float target_error, unsigned int options, float* out_result_error)
+size_t meshopt_simplifyBatch(size_t* result_counts, float* result_errors, const meshopt_SimplifyBatchMesh* meshes, size_t mesh_count, unsigned int options, meshopt_Dispatch dispatch, void* context)
 {
-	return meshopt_simplifyEdge(indices, indices, index_count, vertex_positions_data, vertex_count, vertex_positions_stride, vertex_attributes_data, vertex_attributes_stride, attribute_weights, attribute_count, vertex_lock, target_index_count, target_error, options | meshopt_SimplifyInternalSolve, out_result_error);
+	using namespace meshopt;
+
+	assert((options & (meshopt_SimplifyInternalSolve | meshopt_SimplifyInternalDebug)) == 0);
+
+	meshopt_Allocator allocator;
+
+	// group consecutive meshes into tasks of roughly kSimplifyTaskSize indices so that small meshes don't pay per-task dispatch overhead
+	size_t* task_offsets = allocator.allocate<size_t>(mesh_count + 1);
+	size_t task_count = 0;
+	size_t task_indices = 0;
+
+	for (size_t i = 0; i < mesh_count; ++i)
+	{
+		if (i == 0 || task_indices >= kSimplifyTaskSize)
+		{
+			task_offsets[task_count++] = i;
+			task_indices = 0;
+		}
+
+		task_indices += meshes[i].index_count;
+	}
+
+	task_offsets[task_count] = mesh_count;
+
+	SimplifyBatchJob job = {meshes, task_offsets, options, result_counts, result_errors};
+
+	if (dispatch && task_count > 1)
+		dispatch(context, simplifyBatchTask, &job, task_count);
+	else
+		for (size_t i = 0; i < task_count; ++i)
+			simplifyBatchTask(&job, i);
+
+	size_t result = 0;
+	for (size_t i = 0; i < mesh_count; ++i)
+		result += result_counts[i];
+
+	return result;
 }
 
 size_t meshopt_simplifySloppy(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride, const unsigned char* vertex_lock, size_t target_index_count, float target_error, float* out_result_error)
@@ -2725,56 +3955,131 @@ size_t meshopt_simplifySloppy(unsigned int* destination, const unsigned int* ind
 		next_grid_size = (pass < kInterpolationPasses) ? int(tip + 0.5f) : (min_grid + max_grid) / 2;
 	}
 
-	if (min_triangles == 0)
-	{
-		if (out_result_error)
-			*out_result_error = 1.f;
+	if (min_triangles)
+		computeVertexIds(vertex_ids, vertex_positions, vertex_lock, vertex_count, min_grid);
 
-		return 0;
-	}
+	return simplifySloppyGrid(destination, indices, index_count, vertex_positions, vertex_count, vertex_ids, min_grid, min_triangles, out_result_error);
+}
 
-	// build vertex->cell association by mapping all vertices with the same quantized position to the same cell
-	size_t table_size = hashBuckets2(vertex_count);
-	unsigned int* table = allocator.allocate<unsigned int>(table_size);
+size_t meshopt_simplifySloppyParallel(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride, const unsigned char* vertex_lock, size_t target_index_count, float target_error, float* out_result_error, meshopt_Dispatch dispatch, void* context)
+{
+	using namespace meshopt;
 
-	unsigned int* vertex_cells = allocator.allocate<unsigned int>(vertex_count);
+	assert(index_count % 3 == 0);
+	assert(vertex_positions_stride >= 12 && vertex_positions_stride <= 256);
+	assert(vertex_positions_stride % sizeof(float) == 0);
+	assert(target_index_count <= index_count);
+	assert(target_error >= 0);
 
-	computeVertexIds(vertex_ids, vertex_positions, vertex_lock, vertex_count, min_grid);
-	size_t cell_count = fillVertexCells(table, table_size, vertex_cells, vertex_ids, vertex_count);
+	// we expect to get ~2 triangles/vertex in the output
+	size_t target_cell_count = target_index_count / 6;
+	size_t target_triangles = target_index_count / 3;
 
-	// build a quadric for each target cell
-	Quadric* cell_quadrics = allocator.allocate<Quadric>(cell_count);
-	memset(cell_quadrics, 0, cell_count * sizeof(Quadric));
+	meshopt_Allocator allocator;
 
-	fillCellQuadrics(cell_quadrics, indices, index_count, vertex_positions, vertex_cells);
+	Vector3* vertex_positions = allocator.allocate<Vector3>(vertex_count);
+	rescalePositions(vertex_positions, vertex_positions_data, vertex_count, vertex_positions_stride);
 
-	// for each target cell, find the vertex with the minimal error
-	unsigned int* cell_remap = allocator.allocate<unsigned int>(cell_count);
-	float* cell_errors = allocator.allocate<float>(cell_count);
+	SloppyJob job = {};
+	job.indices = indices;
+	job.index_count = index_count;
+	job.vertex_positions = vertex_positions;
+	job.vertex_lock = vertex_lock;
+	job.vertex_count = vertex_count;
+	job.chunk_count = (index_count / 3 + kSimplifyTaskSize - 1) / kSimplifyTaskSize;
+	job.chunk_triangles = allocator.allocate<size_t>(job.chunk_count * (kSloppyGridCandidates + 1) + 1);
 
-	fillCellRemap(cell_remap, cell_errors, cell_count, vertex_cells, cell_quadrics, vertex_positions, vertex_count);
+	// same invariants as the serial search: # of triangles in min_grid <= target_count unless we're error-limited, max_grid is over the target
+	int min_grid = int(1.f / (target_error < 1e-3f ? 1e-3f : (target_error < 1.f ? target_error : 1.f)));
+	int max_grid = 1025;
+	size_t min_triangles = 0;
+	size_t max_triangles = index_count / 3;
 
-	// compute error
-	float result_error = 0.f;
+	// when we're error-limited, the triangle count for the min. size is computed along with the first round
+	bool measure_min = min_grid > 1 || vertex_lock;
 
-	for (size_t i = 0; i < cell_count; ++i)
-		result_error = result_error < cell_errors[i] ? cell_errors[i] : result_error;
+	// the first round spreads candidates geometrically around the initial guess, within 2x in each direction; triangle count usually grows as a square of grid size
+	float guess = sqrtf(float(target_cell_count));
 
-	// vertex collapses often result in duplicate triangles; we need a table to filter them out
-	size_t tritable_size = hashBuckets2(min_triangles);
-	unsigned int* tritable = allocator.allocate<unsigned int>(tritable_size);
+	for (int round = 0; round < 10; ++round)
+	{
+		if (min_triangles >= target_triangles || max_grid - min_grid <= 1)
+			break;
 
-	// note: this is the first and last write to destination, which allows aliasing destination with indices
-	size_t write = filterTriangles(destination, tritable, tritable_size, indices, index_count, vertex_cells, cell_remap);
+		job.grid_count = 0;
+
+		if (round == 0 && measure_min)
+			job.grid_sizes[job.grid_count++] = min_grid;
+
+		// once the target is bracketed, subsequent rounds cluster candidates around the interpolated grid size, assuming triangle count grows as a square of grid size
+		float tip = float(min_grid) + float(max_grid - min_grid) * 0.5f;
+		float step = float(max_grid - min_grid) / float(kSloppyGridCandidates + 1);
+
+		if (round > 0 && max_grid < 1025 && max_triangles > min_triangles)
+		{
+			float area0 = float(min_grid) * float(min_grid), area1 = float(max_grid) * float(max_grid);
+			tip = sqrtf(area0 + (area1 - area0) * float(target_triangles - min_triangles) / float(max_triangles - min_triangles));
+			step = step * 0.25f < 1.f ? 1.f : step * 0.25f;
+		}
+
+		// candidates are strictly increasing and lie inside the search interval
+		int last_grid = min_grid;
+
+		for (size_t i = 0; i < kSloppyGridCandidates; ++i)
+		{
+			float offset = float(i) - float(kSloppyGridCandidates - 1) * 0.5f;
+			float grid = (round == 0) ? guess * powf(2.f, offset / float(kSloppyGridCandidates / 2)) : tip + step * offset;
+
+			int grid_size = int(grid + 0.5f);
+			grid_size = grid_size <= last_grid ? last_grid + 1 : grid_size;
+
+			if (grid_size >= max_grid)
+				break;
+
+			job.grid_sizes[job.grid_count++] = grid_size;
+			last_grid = grid_size;
+		}
+
+		runSloppyTasks(dispatch, context, countGridTrianglesTask, job, job.grid_count * job.chunk_count);
+
+		for (size_t i = 0; i < job.grid_count; ++i)
+		{
+			size_t triangles = 0;
+			for (size_t j = 0; j < job.chunk_count; ++j)
+				triangles += job.chunk_triangles[i * job.chunk_count + j];
 
 #if TRACE
-	printf("result: grid size %d, %d cells, %d triangles (%d unfiltered), error %e\n", min_grid, int(cell_count), int(write / 3), int(min_triangles), sqrtf(result_error));
+			printf("round %d: grid size %d, triangles %d, %s\n", round, job.grid_sizes[i], int(triangles), (triangles <= target_triangles) ? "under" : "over");
 #endif
 
-	if (out_result_error)
-		*out_result_error = sqrtf(result_error);
+			// the first candidate over the target bounds the search from above; the rest of the candidates are ignored as triangle count isn't monotonic
+			if (job.grid_sizes[i] == min_grid)
+				min_triangles = triangles;
+			else if (triangles <= target_triangles)
+				min_grid = job.grid_sizes[i], min_triangles = triangles;
+			else
+			{
+				max_grid = job.grid_sizes[i], max_triangles = triangles;
+				break;
+			}
 
-	return write;
+			// min. grid already reaches the target (or is over it when we're error-limited), so we can't use a larger grid
+			if (min_triangles >= target_triangles)
+				break;
+		}
+	}
+
+	unsigned int* vertex_ids = allocator.allocate<unsigned int>(vertex_count);
+
+	if (min_triangles)
+	{
+		job.grid_sizes[0] = min_grid;
+		job.vertex_ids = vertex_ids;
+
+		runSloppyTasks(dispatch, context, computeVertexIdsTask, job, (vertex_count + kSimplifyTaskSize - 1) / kSimplifyTaskSize);
+	}
+
+	return simplifySloppyGrid(destination, indices, index_count, vertex_positions, vertex_count, vertex_ids, min_grid, min_triangles, out_result_error);
 }
 
 size_t meshopt_simplifyPrune(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride, float target_error)
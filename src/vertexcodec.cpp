@@ -31,6 +31,13 @@
 #define SIMD_TARGET __attribute__((target("ssse3,popcnt")))
 #endif
 
+// GCC 8+ and clang 6+ support targeting AVX512 VBMI2 from individual functions; we use cpuid to select it at runtime
+#if defined(SIMD_SSE) && ((defined(__clang__) && __clang_major__ >= 6) || (!defined(__clang__) && defined(__GNUC__) && __GNUC__ >= 8)) && defined(__x86_64__)
+#define SIMD_DISPATCH
+#define SIMD_TARGET_AVX512 __attribute__((target("avx2,bmi2,popcnt,avx512vl,avx512bw,avx512vbmi,avx512vbmi2")))
+#define SIMD_FLATTEN __attribute__((flatten))
+#endif
+
 // GCC/clang define these when NEON support is available
 #if defined(__ARM_NEON__) || defined(__ARM_NEON)
 #define SIMD_NEON
@@ -54,6 +61,10 @@
 #define SIMD_TARGET
 #endif
 
+#ifndef SIMD_TARGET_AVX512
+#define SIMD_TARGET_AVX512
+#endif
+
 // When targeting AArch64/x64, optimize for latency to allow decoding of individual 16-byte groups to overlap
 // We don't do this for 32-bit systems because we need 64-bit math for this and this will hurt in-order CPUs
 #if (defined(__x86_64__) || defined(_M_X64) || defined(__aarch64__) || defined(_M_ARM64) || defined(_M_ARM64EC)) && !defined(MESHOPTIMIZER_VERTEXCODEC_SIMDNOLOPT)
@@ -75,7 +86,7 @@
 #include <nmmintrin.h>
 #endif
 
-#if defined(SIMD_SSE) && defined(SIMD_FALLBACK)
+#if defined(SIMD_SSE) && (defined(SIMD_FALLBACK) || defined(SIMD_DISPATCH))
 #ifdef _MSC_VER
 #include <intrin.h> // __cpuid
 #else
@@ -83,7 +94,7 @@
 #endif
 #endif
 
-#ifdef SIMD_AVX
+#if defined(SIMD_AVX) || defined(SIMD_DISPATCH)
 #include <immintrin.h>
 #endif
 
@@ -366,19 +377,21 @@ static int estimateBits(unsigned char v)
 	return v <= 15 ? (v <= 3 ? (v == 0 ? 0 : 2) : 4) : 8;
 }
 
-static int estimateRotate(const unsigned char* vertex_data, size_t vertex_count, size_t vertex_size, size_t k, size_t group_size)
+static void estimateRotateSizes(size_t sizes[8], const unsigned char* vertex_data, size_t vertex_begin, size_t vertex_end, size_t vertex_size, size_t k, size_t group_size)
 {
-	size_t sizes[8] = {};
+	assert(vertex_begin % group_size == 0);
+
+	const unsigned char* last_vertex = vertex_data + (vertex_begin == 0 ? 0 : vertex_begin - 1) * vertex_size + k;
+	unsigned int last = last_vertex[0] | (last_vertex[1] << 8) | (last_vertex[2] << 16) | (last_vertex[3] << 24);
 
-	const unsigned char* vertex = vertex_data + k;
-	unsigned int last = vertex[0] | (vertex[1] << 8) | (vertex[2] << 16) | (vertex[3] << 24);
+	const unsigned char* vertex = vertex_data + vertex_begin * vertex_size + k;
 
-	for (size_t i = 0; i < vertex_count; i += group_size)
+	for (size_t i = vertex_begin; i < vertex_end; i += group_size)
 	{
 		unsigned int bitg = 0;
 
 		// calculate bit consistency mask for the group
-		for (size_t j = 0; j < group_size && i + j < vertex_count; ++j)
+		for (size_t j = 0; j < group_size && i + j < vertex_end; ++j)
 		{
 			unsigned int v = vertex[0] | (vertex[1] << 8) | (vertex[2] << 16) | (vertex[3] << 24);
 			unsigned int d = v ^ last;
@@ -390,7 +403,7 @@ static int estimateRotate(const unsigned char* vertex_data, size_t vertex_count,
 
 #if TRACE
 		for (int j = 0; j < 32; ++j)
-			vertexstats[k + (j / 8)].bitc[j % 8] += (i + group_size < vertex_count ? group_size : vertex_count - i) * (1 - ((bitg >> j) & 1));
+			vertexstats[k + (j / 8)].bitc[j % 8] += (i + group_size < vertex_end ? group_size : vertex_end - i) * (1 - ((bitg >> j) & 1));
 #endif
 
 		for (int j = 0; j < 8; ++j)
@@ -401,7 +414,10 @@ static int estimateRotate(const unsigned char* vertex_data, size_t vertex_count,
 			sizes[j] += estimateBits((unsigned char)(bitr >> 16)) + estimateBits((unsigned char)(bitr >> 24));
 		}
 	}
+}
 
+static int estimateRotateBest(const size_t sizes[8])
+{
 	int best_rot = 0;
 	for (int rot = 1; rot < 8; ++rot)
 		best_rot = (sizes[rot] < sizes[best_rot]) ? rot : best_rot;
@@ -409,17 +425,27 @@ static int estimateRotate(const unsigned char* vertex_data, size_t vertex_count,
 	return best_rot;
 }
 
-static int estimateChannel(const unsigned char* vertex_data, size_t vertex_count, size_t vertex_size, size_t k, size_t vertex_block_size, size_t block_skip, int max_channel, int xor_rot)
+static int estimateRotate(const unsigned char* vertex_data, size_t vertex_count, size_t vertex_size, size_t k, size_t group_size)
+{
+	size_t sizes[8] = {};
+	estimateRotateSizes(sizes, vertex_data, 0, vertex_count, vertex_size, k, group_size);
+
+	return estimateRotateBest(sizes);
+}
+
+static void estimateChannelSizes(size_t sizes[3], const unsigned char* vertex_data, size_t vertex_begin, size_t vertex_end, size_t vertex_count, size_t vertex_size, size_t k, size_t vertex_block_size, size_t block_skip, int max_channel, int xor_rot)
 {
 	unsigned char block[kVertexBlockMaxSize];
 	assert(vertex_block_size <= kVertexBlockMaxSize);
 
 	unsigned char last_vertex[256] = {};
 
-	size_t sizes[3] = {};
 	assert(max_channel <= 3);
 
-	for (size_t i = 0; i < vertex_count; i += vertex_block_size * block_skip)
+	// only every block_skip-th block is evaluated; to get consistent results for sub-ranges, we start from the first such block in range
+	size_t block_stride = vertex_block_size * block_skip;
+
+	for (size_t i = (vertex_begin + block_stride - 1) / block_stride * block_stride; i < vertex_end; i += block_stride)
 	{
 		size_t block_size = i + vertex_block_size < vertex_count ? vertex_block_size : vertex_count - i;
 		size_t block_size_aligned = (block_size + kByteGroupSize - 1) & ~(kByteGroupSize - 1);
@@ -451,7 +477,10 @@ static int estimateChannel(const unsigned char* vertex_data, size_t vertex_count
 				}
 			}
 	}
+}
 
+static int estimateChannelBest(const size_t sizes[3], int max_channel, int xor_rot)
+{
 	int best_channel = 0;
 	for (int channel = 1; channel < max_channel; ++channel)
 		best_channel = (sizes[channel] < sizes[best_channel]) ? channel : best_channel;
@@ -459,6 +488,14 @@ static int estimateChannel(const unsigned char* vertex_data, size_t vertex_count
 	return best_channel == 2 ? best_channel | (xor_rot << 4) : best_channel;
 }
 
+static int estimateChannel(const unsigned char* vertex_data, size_t vertex_count, size_t vertex_size, size_t k, size_t vertex_block_size, size_t block_skip, int max_channel, int xor_rot)
+{
+	size_t sizes[3] = {};
+	estimateChannelSizes(sizes, vertex_data, 0, vertex_count, vertex_count, vertex_size, k, vertex_block_size, block_skip, max_channel, xor_rot);
+
+	return estimateChannelBest(sizes, max_channel, xor_rot);
+}
+
 static bool estimateControlZero(const unsigned char* buffer, size_t vertex_count_aligned)
 {
 	for (size_t i = 0; i < vertex_count_aligned; i += kByteGroupSize)
@@ -578,6 +615,118 @@ static unsigned char* encodeVertexBlock(unsigned char* data, unsigned char* data
 	return data;
 }
 
+static unsigned char* encodeVertexTail(unsigned char* data, unsigned char* data_end, const unsigned char* first_vertex, const unsigned char* channels, size_t vertex_size, int version)
+{
+	size_t tail_size = vertex_size + (version == 0 ? 0 : vertex_size / 4);
+	size_t tail_size_min = version == 0 ? kTailMinSizeV0 : kTailMinSizeV1;
+	size_t tail_size_pad = tail_size < tail_size_min ? tail_size_min : tail_size;
+
+	if (size_t(data_end - data) < tail_size_pad)
+		return NULL;
+
+	if (tail_size < tail_size_pad)
+	{
+		memset(data, 0, tail_size_pad - tail_size);
+		data += tail_size_pad - tail_size;
+	}
+
+	memcpy(data, first_vertex, vertex_size);
+	data += vertex_size;
+
+	if (version != 0)
+	{
+		memcpy(data, channels, vertex_size / 4);
+		data += vertex_size / 4;
+	}
+
+	return data;
+}
+
+// number of blocks in each parallel encoding task; smaller segments improve load balancing but increase dispatch overhead
+const size_t kVertexEncodeSegmentBlocks = 24;
+
+struct VertexEncodeJob
+{
+	const unsigned char* vertex_data;
+	size_t vertex_count;
+	size_t vertex_size;
+	size_t vertex_block_size;
+
+	int version;
+	int level;
+
+	size_t segment_size;
+	size_t segment_count;
+	size_t segment_capacity;
+
+	size_t* rotate_sizes;
+	size_t* channel_sizes;
+	unsigned char rotates[64];
+	unsigned char channels[64];
+
+	unsigned char* segment_data;
+	size_t* segment_results;
+};
+
+static void encodeVertexRotateTask(void* context, size_t index)
+{
+	const VertexEncodeJob& job = *static_cast<VertexEncodeJob*>(context);
+
+	size_t k = (index / job.segment_count) * 4;
+	size_t begin = (index % job.segment_count) * job.segment_size;
+	size_t end = begin + job.segment_size < job.vertex_count ? begin + job.segment_size : job.vertex_count;
+
+	estimateRotateSizes(&job.rotate_sizes[index * 8], job.vertex_data, begin, end, job.vertex_size, k, /* group_size= */ 16);
+}
+
+static void encodeVertexChannelTask(void* context, size_t index)
+{
+	const VertexEncodeJob& job = *static_cast<VertexEncodeJob*>(context);
+
+	size_t k = (index / job.segment_count) * 4;
+	size_t begin = (index % job.segment_count) * job.segment_size;
+	size_t end = begin + job.segment_size < job.vertex_count ? begin + job.segment_size : job.vertex_count;
+
+	estimateChannelSizes(&job.channel_sizes[index * 3], job.vertex_data, begin, end, job.vertex_count, job.vertex_size, k, job.vertex_block_size, /* block_skip= */ 3, /* max_channel= */ job.level >= 3 ? 3 : 2, job.rotates[k / 4]);
+}
+
+static void encodeVertexSegmentTask(void* context, size_t index)
+{
+	const VertexEncodeJob& job = *static_cast<VertexEncodeJob*>(context);
+
+	size_t begin = index * job.segment_size;
+	size_t end = begin + job.segment_size < job.vertex_count ? begin + job.segment_size : job.vertex_count;
+
+	// each block is encoded relative to the last vertex of the previous block, so segments can be encoded independently
+	unsigned char last_vertex[256];
+	memcpy(last_vertex, job.vertex_data + (begin == 0 ? 0 : begin - 1) * job.vertex_size, job.vertex_size);
+
+	unsigned char* data = job.segment_data + index * job.segment_capacity;
+	unsigned char* data_end = data + job.segment_capacity;
+
+	for (size_t i = begin; i < end; i += job.vertex_block_size)
+	{
+		size_t block_size = (i + job.vertex_block_size < end) ? job.vertex_block_size : end - i;
+
+		data = encodeVertexBlock(data, data_end, job.vertex_data + i * job.vertex_size, block_size, job.vertex_size, last_vertex, job.channels, job.version, job.level);
+		assert(data); // segment capacity is computed from the worst case block size
+	}
+
+	job.segment_results[index] = data - (job.segment_data + index * job.segment_capacity);
+}
+
+static void runVertexEncodeTasks(meshopt_Dispatch dispatch, void* context, void (*task)(void*, size_t), VertexEncodeJob& job, size_t task_count)
+{
+	if (task_count == 0)
+		return;
+
+	if (dispatch)
+		dispatch(context, task, &job, task_count);
+	else
+		for (size_t i = 0; i < task_count; ++i)
+			task(&job, i);
+}
+
 #if defined(SIMD_FALLBACK) || (!defined(SIMD_SSE) && !defined(SIMD_NEON) && !defined(SIMD_AVX) && !defined(SIMD_WASM))
 static const unsigned char* decodeBytesGroup(const unsigned char* data, unsigned char* buffer, int bits)
 {
@@ -892,9 +1041,9 @@ static inline const unsigned char* decodeBytesGroupSimd(const unsigned char* dat
 }
 #endif
 
-#ifdef SIMD_AVX
+#if defined(SIMD_AVX) || defined(SIMD_DISPATCH)
 // sent mask, multishift control
-static const unsigned char kDecodeBytesGroupConfig[9][2][16] = {
+static const unsigned char kDecodeBytesGroupConfigAvx512[9][2][16] = {
     {{0}, {0}},
     {{3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3}, {6, 4, 2, 0, 14, 12, 10, 8, 22, 20, 18, 16, 30, 28, 26, 24}},
     {{15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15}, {4, 0, 12, 8, 20, 16, 28, 24, 36, 32, 44, 40, 52, 48, 60, 56}},
@@ -906,8 +1055,8 @@ static const unsigned char kDecodeBytesGroupConfig[9][2][16] = {
     {{0}, {0}},
 };
 
-SIMD_TARGET
-static inline const unsigned char* decodeBytesGroupSimd(const unsigned char* data, unsigned char* buffer, int hbits)
+SIMD_TARGET_AVX512
+static inline const unsigned char* decodeBytesGroupSimdAvx512(const unsigned char* data, unsigned char* buffer, int hbits)
 {
 	// 0 for 1-bit, 1 for 2-bit, 2 for 4-bit, 3 for 8-bit, and 4 for 0-bit as it makes some of the uses easier
 	static const int hbtn[9] = {4, 1, 2, 3, 4, 0, 1, 2, 3};
@@ -932,12 +1081,13 @@ static inline const unsigned char* decodeBytesGroupSimd(const unsigned char* dat
 	__m128i selb = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(data));
 	__m128i rest = _mm_maskz_loadu_epi8(__mmask16((n >> 2) - 1), skip);
 
-	__m128i sent = _mm_loadu_si128(reinterpret_cast<const __m128i*>(kDecodeBytesGroupConfig[hbits][0]));
-	__m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(kDecodeBytesGroupConfig[hbits][1]));
+	__m128i sent = _mm_loadu_si128(reinterpret_cast<const __m128i*>(kDecodeBytesGroupConfigAvx512[hbits][0]));
+	__m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(kDecodeBytesGroupConfigAvx512[hbits][1]));
 
 	// unpack 1, 2 or 4-bit values using multishift and mask the result; for 0/8-bit values, sel is always 0
+	// note: we use zero-masking form as the unmasked intrinsic triggers -Wmaybe-uninitialized in some gcc versions
 	__m128i selw = _mm_shuffle_epi32(selb, 0x44);
-	__m128i sel = _mm_and_si128(sent, _mm_multishift_epi64_epi8(ctrl, selw));
+	__m128i sel = _mm_and_si128(sent, _mm_maskz_multishift_epi64_epi8(__mmask16(0xffff), ctrl, selw));
 
 	// compare sel to sentinel and combine; mask is 0 for 0/8-bit as sent is 0
 	__mmask16 mask16 = _mm_cmp_epi8_mask(sel, sent, _MM_CMPINT_EQ);
@@ -1365,12 +1515,22 @@ inline v128_t rotate32(v128_t v, int r)
 #endif
 
 #if defined(SIMD_SSE) || defined(SIMD_AVX) || defined(SIMD_NEON) || defined(SIMD_WASM)
-SIMD_TARGET
-static const unsigned char* decodeBytesSimd(const unsigned char* data, const unsigned char* data_end, unsigned char* buffer, size_t buffer_size, int hshift)
+template <bool Avx512>
+SIMD_TARGET static const unsigned char*
+decodeBytesSimd(const unsigned char* data, const unsigned char* data_end, unsigned char* buffer, size_t buffer_size, int hshift)
 {
 	assert(buffer_size % kByteGroupSize == 0);
 	assert(kByteGroupSize == 16);
 
+	// AVX512 group decoder is selected at compile time, or at runtime when the caller is compiled for AVX512 (see decodeVertexBlockAvx512)
+#if defined(SIMD_AVX)
+#define DECODE(data, buffer, hbits) decodeBytesGroupSimdAvx512(data, buffer, hbits)
+#elif defined(SIMD_DISPATCH)
+#define DECODE(data, buffer, hbits) (Avx512 ? decodeBytesGroupSimdAvx512(data, buffer, hbits) : decodeBytesGroupSimd(data, buffer, hbits))
+#else
+#define DECODE(data, buffer, hbits) decodeBytesGroupSimd(data, buffer, hbits)
+#endif
+
 	// round number of groups to 4 to get number of header bytes
 	size_t header_size = (buffer_size / kByteGroupSize + 3) / 4;
 	if (size_t(data_end - data) < header_size)
@@ -1403,10 +1563,10 @@ static const unsigned char* decodeBytesSimd(const unsigned char* data, const uns
 		}
 #endif
 
-		data = decodeBytesGroupSimd(data, buffer + i + kByteGroupSize * 0, hshift + ((header_byte >> 0) & 3));
-		data = decodeBytesGroupSimd(data, buffer + i + kByteGroupSize * 1, hshift + ((header_byte >> 2) & 3));
-		data = decodeBytesGroupSimd(data, buffer + i + kByteGroupSize * 2, hshift + ((header_byte >> 4) & 3));
-		data = decodeBytesGroupSimd(data, buffer + i + kByteGroupSize * 3, hshift + ((header_byte >> 6) & 3));
+		data = DECODE(data, buffer + i + kByteGroupSize * 0, hshift + ((header_byte >> 0) & 3));
+		data = DECODE(data, buffer + i + kByteGroupSize * 1, hshift + ((header_byte >> 2) & 3));
+		data = DECODE(data, buffer + i + kByteGroupSize * 2, hshift + ((header_byte >> 4) & 3));
+		data = DECODE(data, buffer + i + kByteGroupSize * 3, hshift + ((header_byte >> 6) & 3));
 	}
 
 	// slow-path: process remaining groups
@@ -1418,9 +1578,11 @@ static const unsigned char* decodeBytesSimd(const unsigned char* data, const uns
 		size_t header_offset = i / kByteGroupSize;
 		unsigned char header_byte = header[header_offset / 4];
 
-		data = decodeBytesGroupSimd(data, buffer + i, hshift + ((header_byte >> ((header_offset % 4) * 2)) & 3));
+		data = DECODE(data, buffer + i, hshift + ((header_byte >> ((header_offset % 4) * 2)) & 3));
 	}
 
+#undef DECODE
+
 	return data;
 }
 
@@ -1510,8 +1672,9 @@ decodeDeltas4Simd(const unsigned char* buffer, unsigned char* transposed, size_t
 	}
 }
 
-SIMD_TARGET
-static const unsigned char* decodeVertexBlockSimd(const unsigned char* data, const unsigned char* data_end, unsigned char* vertex_data, size_t vertex_count, size_t vertex_size, unsigned char last_vertex[256], const unsigned char* channels, int version)
+template <bool Avx512>
+SIMD_TARGET static const unsigned char*
+decodeVertexBlockSimd(const unsigned char* data, const unsigned char* data_end, unsigned char* vertex_data, size_t vertex_count, size_t vertex_size, unsigned char last_vertex[256], const unsigned char* channels, int version)
 {
 	assert(vertex_count > 0 && vertex_count <= kVertexBlockMaxSize);
 
@@ -1562,7 +1725,7 @@ static const unsigned char* decodeVertexBlockSimd(const unsigned char* data, con
 				// for v0, headers are mapped to 0..3; for v1, headers are mapped to 4..8
 				int hshift = version == 0 ? 0 : 4 + ctrl;
 
-				data = decodeBytesSimd(data, data_end, buffer + j * vertex_count_aligned, vertex_count_aligned, hshift);
+				data = decodeBytesSimd<Avx512>(data, data_end, buffer + j * vertex_count_aligned, vertex_count_aligned, hshift);
 				if (!data)
 					return NULL;
 			}
@@ -1595,8 +1758,17 @@ static const unsigned char* decodeVertexBlockSimd(const unsigned char* data, con
 }
 #endif
 
-#if defined(SIMD_SSE) && defined(SIMD_FALLBACK)
-static unsigned int getCpuFeatures()
+#ifdef SIMD_DISPATCH
+// the block decoder is inlined into this wrapper so that the entire block is compiled for the wider instruction set
+SIMD_TARGET_AVX512 SIMD_FLATTEN static const unsigned char*
+decodeVertexBlockAvx512(const unsigned char* data, const unsigned char* data_end, unsigned char* vertex_data, size_t vertex_count, size_t vertex_size, unsigned char last_vertex[256], const unsigned char* channels, int version)
+{
+	return decodeVertexBlockSimd<true>(data, data_end, vertex_data, vertex_count, vertex_size, last_vertex, channels, version);
+}
+#endif
+
+#if defined(SIMD_SSE) && (defined(SIMD_FALLBACK) || defined(SIMD_DISPATCH))
+static int getCpuLevel()
 {
 	int cpuinfo[4] = {};
 #ifdef _MSC_VER
@@ -1604,15 +1776,92 @@ static unsigned int getCpuFeatures()
 #else
 	__cpuid(1, cpuinfo[0], cpuinfo[1], cpuinfo[2], cpuinfo[3]);
 #endif
-	return cpuinfo[2];
+
+	const int cpumask = (1 << 9) | (1 << 23); // SSSE3+POPCNT
+	if ((cpuinfo[2] & cpumask) != cpumask)
+		return 0;
+
+#ifdef SIMD_DISPATCH
+	// AVX/AVX512 state must be enabled by the OS (OSXSAVE+XCR0), in addition to the CPU supporting the instructions
+	const int osmask = (1 << 27) | (1 << 28); // OSXSAVE+AVX
+	if ((cpuinfo[2] & osmask) != osmask || __get_cpuid_max(0, NULL) < 7)
+		return 1;
+
+	unsigned int xcr0, xcr0h;
+	__asm__("xgetbv" : "=a"(xcr0), "=d"(xcr0h) : "c"(0));
+	(void)xcr0h;
+
+	int cpuinfo7[4] = {};
+	__cpuid_count(7, 0, cpuinfo7[0], cpuinfo7[1], cpuinfo7[2], cpuinfo7[3]);
+
+	const int avx2mask = (1 << 5) | (1 << 8);                                  // AVX2+BMI2
+	const int avx512mask = (1 << 30) | int(1u << 31);                           // AVX512BW+AVX512VL
+	const int vbmimask = (1 << 1) | (1 << 6);                                   // AVX512VBMI+AVX512VBMI2
+	const unsigned int ymmstate = (1 << 1) | (1 << 2);                          // SSE+AVX state
+	const unsigned int zmmstate = ymmstate | (1 << 5) | (1 << 6) | (1 << 7);    // opmask+ZMM state
+
+	if ((cpuinfo7[1] & avx2mask) != avx2mask || (cpuinfo7[1] & avx512mask) != avx512mask || (cpuinfo7[2] & vbmimask) != vbmimask || (xcr0 & zmmstate) != zmmstate)
+		return 1;
+
+	return 2;
+#else
+	return 1;
+#endif
+}
+#endif
+
+static int getSimdLevel()
+{
+#if defined(SIMD_AVX)
+	return 2;
+#elif defined(SIMD_SSE) && (defined(SIMD_FALLBACK) || defined(SIMD_DISPATCH))
+	return getCpuLevel();
+#elif defined(SIMD_SSE) || defined(SIMD_NEON) || defined(SIMD_WASM)
+	return 1;
+#else
+	return 0;
+#endif
 }
 
-static unsigned int cpuid = getCpuFeatures();
+static const int kDecodeVertexSimdLevel = getSimdLevel();
+static int gDecodeVertexSimdLevel = kDecodeVertexSimdLevel;
+
+typedef const unsigned char* (*DecodeVertexBlockFn)(const unsigned char*, const unsigned char*, unsigned char*, size_t, size_t, unsigned char[256], const unsigned char*, int);
+
+static DecodeVertexBlockFn getDecodeVertexBlock()
+{
+#if defined(SIMD_SSE) || defined(SIMD_NEON) || defined(SIMD_WASM)
+	assert(gDecodeBytesGroupInitialized);
+	(void)gDecodeBytesGroupInitialized;
+#endif
+
+#if defined(SIMD_DISPATCH) && defined(SIMD_FALLBACK)
+	return gDecodeVertexSimdLevel >= 2 ? decodeVertexBlockAvx512 : gDecodeVertexSimdLevel == 1 ? decodeVertexBlockSimd<false> : decodeVertexBlock;
+#elif defined(SIMD_DISPATCH)
+	return gDecodeVertexSimdLevel >= 2 ? decodeVertexBlockAvx512 : decodeVertexBlockSimd<false>;
+#elif defined(SIMD_FALLBACK)
+	return gDecodeVertexSimdLevel >= 1 ? decodeVertexBlockSimd<false> : decodeVertexBlock;
+#elif defined(SIMD_SSE) || defined(SIMD_AVX) || defined(SIMD_NEON) || defined(SIMD_WASM)
+	return decodeVertexBlockSimd<false>;
+#else
+	return decodeVertexBlock;
 #endif
+}
+
+// each seek table entry stores the block offset (32-bit little endian) followed by the vertex that precedes the block
+static size_t getVertexSeekEntrySize(size_t vertex_size)
+{
+	return 4 + vertex_size;
+}
 
 } // namespace meshopt
 
 size_t meshopt_encodeVertexBufferLevel(unsigned char* buffer, size_t buffer_size, const void* vertices, size_t vertex_count, size_t vertex_size, int level, int version)
+{
+	return meshopt_encodeVertexBufferSeekable(buffer, buffer_size, NULL, 0, vertices, vertex_count, vertex_size, level, version);
+}
+
+size_t meshopt_encodeVertexBufferSeekable(unsigned char* buffer, size_t buffer_size, unsigned char* seek, size_t seek_size, const void* vertices, size_t vertex_count, size_t vertex_size, int level, int version)
 {
 	using namespace meshopt;
 
@@ -1646,6 +1895,9 @@ size_t meshopt_encodeVertexBufferLevel(unsigned char* buffer, size_t buffer_size
 
 	size_t vertex_block_size = getVertexBlockSize(vertex_size);
 
+	if (seek && seek_size < meshopt_encodeVertexSeekSize(vertex_count, vertex_size))
+		return 0;
+
 	unsigned char channels[64] = {};
 	if (version != 0 && level > 1 && vertex_count > 1)
 		for (size_t k = 0; k < vertex_size; k += 4)
@@ -1663,6 +1915,21 @@ size_t meshopt_encodeVertexBufferLevel(unsigned char* buffer, size_t buffer_size
 	{
 		size_t block_size = (vertex_offset + vertex_block_size < vertex_count) ? vertex_block_size : vertex_count - vertex_offset;
 
+		if (seek)
+		{
+			unsigned char* entry = seek + (vertex_offset / vertex_block_size) * getVertexSeekEntrySize(vertex_size);
+			size_t offset = data - buffer;
+
+			if (offset > size_t(~0u))
+				return 0;
+
+			entry[0] = (unsigned char)(offset >> 0);
+			entry[1] = (unsigned char)(offset >> 8);
+			entry[2] = (unsigned char)(offset >> 16);
+			entry[3] = (unsigned char)(offset >> 24);
+			memcpy(entry + 4, last_vertex, vertex_size);
+		}
+
 		data = encodeVertexBlock(data, data_end, vertex_data + vertex_offset * vertex_size, block_size, vertex_size, last_vertex, channels, version, level);
 		if (!data)
 			return 0;
@@ -1670,29 +1937,10 @@ size_t meshopt_encodeVertexBufferLevel(unsigned char* buffer, size_t buffer_size
 		vertex_offset += block_size;
 	}
 
-	size_t tail_size = vertex_size + (version == 0 ? 0 : vertex_size / 4);
-	size_t tail_size_min = version == 0 ? kTailMinSizeV0 : kTailMinSizeV1;
-	size_t tail_size_pad = tail_size < tail_size_min ? tail_size_min : tail_size;
-
-	if (size_t(data_end - data) < tail_size_pad)
+	data = encodeVertexTail(data, data_end, first_vertex, channels, vertex_size, version);
+	if (!data)
 		return 0;
 
-	if (tail_size < tail_size_pad)
-	{
-		memset(data, 0, tail_size_pad - tail_size);
-		data += tail_size_pad - tail_size;
-	}
-
-	memcpy(data, first_vertex, vertex_size);
-	data += vertex_size;
-
-	if (version != 0)
-	{
-		memcpy(data, channels, vertex_size / 4);
-		data += vertex_size / 4;
-	}
-
-	assert(data >= buffer + tail_size);
 	assert(data <= buffer + buffer_size);
 
 #if TRACE
@@ -1745,11 +1993,249 @@ size_t meshopt_encodeVertexBufferLevel(unsigned char* buffer, size_t buffer_size
 	return data - buffer;
 }
 
+size_t meshopt_encodeVertexBufferParallel(unsigned char* buffer, size_t buffer_size, const void* vertices, size_t vertex_count, size_t vertex_size, int level, int version, meshopt_Dispatch dispatch, void* context)
+{
+	using namespace meshopt;
+
+	assert(vertex_size > 0 && vertex_size <= 256);
+	assert(vertex_size % 4 == 0);
+	assert(level >= 0 && level <= 9); // only a subset of this range is used right now
+	assert(version < 0 || unsigned(version) <= kDecodeVertexVersion);
+
+	version = version < 0 ? gEncodeVertexVersion : version;
+
+	meshopt_Allocator allocator;
+
+	const unsigned char* vertex_data = static_cast<const unsigned char*>(vertices);
+
+	unsigned char* data = buffer;
+	unsigned char* data_end = buffer + buffer_size;
+
+	if (size_t(data_end - data) < 1)
+		return 0;
+
+	*data++ = (unsigned char)(kVertexHeader | version);
+
+	VertexEncodeJob job = {};
+	job.vertex_data = vertex_data;
+	job.vertex_count = vertex_count;
+	job.vertex_size = vertex_size;
+	job.vertex_block_size = getVertexBlockSize(vertex_size);
+	job.version = version;
+	job.level = level;
+
+	job.segment_size = job.vertex_block_size * kVertexEncodeSegmentBlocks;
+	job.segment_count = (vertex_count + job.segment_size - 1) / job.segment_size;
+
+	size_t channel_count = vertex_size / 4;
+
+	// channel estimation sums per-segment size estimates; since the sums are exact, the results match estimateRotate/estimateChannel
+	if (version != 0 && level > 1 && vertex_count > 1)
+	{
+		if (level >= 3)
+		{
+			job.rotate_sizes = allocator.allocate<size_t>(channel_count * job.segment_count * 8);
+			memset(job.rotate_sizes, 0, channel_count * job.segment_count * 8 * sizeof(size_t));
+
+			runVertexEncodeTasks(dispatch, context, encodeVertexRotateTask, job, channel_count * job.segment_count);
+
+			for (size_t c = 0; c < channel_count; ++c)
+			{
+				size_t sizes[8] = {};
+				for (size_t i = 0; i < job.segment_count; ++i)
+					for (int j = 0; j < 8; ++j)
+						sizes[j] += job.rotate_sizes[(c * job.segment_count + i) * 8 + j];
+
+				job.rotates[c] = (unsigned char)estimateRotateBest(sizes);
+			}
+		}
+
+		job.channel_sizes = allocator.allocate<size_t>(channel_count * job.segment_count * 3);
+		memset(job.channel_sizes, 0, channel_count * job.segment_count * 3 * sizeof(size_t));
+
+		runVertexEncodeTasks(dispatch, context, encodeVertexChannelTask, job, channel_count * job.segment_count);
+
+		for (size_t c = 0; c < channel_count; ++c)
+		{
+			size_t sizes[3] = {};
+			for (size_t i = 0; i < job.segment_count; ++i)
+				for (int j = 0; j < 3; ++j)
+					sizes[j] += job.channel_sizes[(c * job.segment_count + i) * 3 + j];
+
+			int channel = estimateChannelBest(sizes, level >= 3 ? 3 : 2, job.rotates[c]);
+
+			assert(unsigned(channel) < 2 || ((channel & 3) == 2 && unsigned(channel >> 4) < 8));
+			job.channels[c] = (unsigned char)channel;
+		}
+	}
+
+	// worst case block encoding, plus extra space for the group decode limit check in encodeBytes
+	size_t block_header_size = (job.vertex_block_size / kByteGroupSize + 3) / 4;
+	size_t block_capacity = channel_count + vertex_size * (block_header_size + job.vertex_block_size);
+
+	job.segment_capacity = block_capacity * kVertexEncodeSegmentBlocks + kByteGroupDecodeLimit;
+	job.segment_data = allocator.allocate<unsigned char>(job.segment_capacity * job.segment_count);
+	job.segment_results = allocator.allocate<size_t>(job.segment_count);
+
+	runVertexEncodeTasks(dispatch, context, encodeVertexSegmentTask, job, job.segment_count);
+
+	for (size_t i = 0; i < job.segment_count; ++i)
+	{
+		size_t segment_size = job.segment_results[i];
+
+		if (size_t(data_end - data) < segment_size)
+			return 0;
+
+		memcpy(data, job.segment_data + i * job.segment_capacity, segment_size);
+		data += segment_size;
+	}
+
+	unsigned char first_vertex[256] = {};
+	if (vertex_count > 0)
+		memcpy(first_vertex, vertex_data, vertex_size);
+
+	data = encodeVertexTail(data, data_end, first_vertex, job.channels, vertex_size, version);
+	if (!data)
+		return 0;
+
+	assert(data <= buffer + buffer_size);
+
+	return data - buffer;
+}
+
 size_t meshopt_encodeVertexBuffer(unsigned char* buffer, size_t buffer_size, const void* vertices, size_t vertex_count, size_t vertex_size)
 {
 	return meshopt_encodeVertexBufferLevel(buffer, buffer_size, vertices, vertex_count, vertex_size, meshopt::kEncodeDefaultLevel, meshopt::gEncodeVertexVersion);
 }
 
+size_t meshopt_encodeVertexBufferRef(unsigned char* buffer, size_t buffer_size, const void* vertices, size_t vertex_count, size_t vertex_size, const void* reference, int level, int version)
+{
+	assert(vertex_size > 0 && vertex_size <= 256);
+	assert(vertex_size % 4 == 0);
+
+	meshopt_Allocator allocator;
+
+	const unsigned char* vertex_data = static_cast<const unsigned char*>(vertices);
+	const unsigned char* reference_data = static_cast<const unsigned char*>(reference);
+
+	// byte-wise residuals are zero where the data matches the reference; delta coding of residuals handles smooth deviations
+	unsigned char* residual = allocator.allocate<unsigned char>(vertex_count * vertex_size);
+
+	for (size_t i = 0; i < vertex_count * vertex_size; ++i)
+		residual[i] = (unsigned char)(vertex_data[i] - reference_data[i]);
+
+	return meshopt_encodeVertexBufferLevel(buffer, buffer_size, residual, vertex_count, vertex_size, level, version);
+}
+
+namespace meshopt
+{
+
+static void flushVertexStream(meshopt_VertexStreamEncoder* encoder)
+{
+	size_t vertex_size = encoder->vertex_size;
+	size_t block_size = encoder->block_vertices;
+
+	assert(block_size > 0);
+
+	// first block initializes the state; channels can only be estimated from the data seen so far
+	if (encoder->vertex_count == block_size)
+	{
+		memcpy(encoder->first_vertex, encoder->block, vertex_size);
+		memcpy(encoder->last_vertex, encoder->block, vertex_size);
+
+		if (encoder->version != 0 && encoder->level > 1 && block_size > 1)
+			for (size_t k = 0; k < vertex_size; k += 4)
+			{
+				int rot = encoder->level >= 3 ? estimateRotate(encoder->block, block_size, vertex_size, k, /* group_size= */ 16) : 0;
+				int channel = estimateChannel(encoder->block, block_size, vertex_size, k, getVertexBlockSize(vertex_size), /* block_skip= */ 3, /* max_channel= */ encoder->level >= 3 ? 3 : 2, rot);
+
+				encoder->channels[k / 4] = (unsigned char)channel;
+			}
+	}
+
+	// control bytes and group headers add at most 448 bytes to the 8 KB of block data
+	unsigned char scratch[kVertexBlockSizeBytes * 2];
+
+	unsigned char* end = encodeVertexBlock(scratch, scratch + sizeof(scratch), encoder->block, block_size, vertex_size, encoder->last_vertex, encoder->channels, encoder->version, encoder->level);
+	assert(end);
+
+	encoder->sink(encoder->context, scratch, end - scratch);
+	encoder->output_size += end - scratch;
+	encoder->block_vertices = 0;
+}
+
+} // namespace meshopt
+
+void meshopt_encodeVertexStreamBegin(struct meshopt_VertexStreamEncoder* encoder, size_t vertex_size, int level, int version, void (*sink)(void* context, const unsigned char* data, size_t size), void* context)
+{
+	using namespace meshopt;
+
+	assert(vertex_size > 0 && vertex_size <= 256);
+	assert(vertex_size % 4 == 0);
+	assert(level >= 0 && level <= 9);
+	assert(version < 0 || unsigned(version) <= kDecodeVertexVersion);
+	assert(sizeof(encoder->block) >= kVertexBlockSizeBytes);
+
+	memset(encoder, 0, sizeof(*encoder));
+
+	encoder->sink = sink;
+	encoder->context = context;
+	encoder->vertex_size = vertex_size;
+	encoder->level = level;
+	encoder->version = version < 0 ? gEncodeVertexVersion : version;
+
+	unsigned char header = (unsigned char)(kVertexHeader | encoder->version);
+
+	sink(context, &header, 1);
+	encoder->output_size = 1;
+}
+
+void meshopt_encodeVertexStreamAppend(struct meshopt_VertexStreamEncoder* encoder, const void* vertices, size_t vertex_count)
+{
+	using namespace meshopt;
+
+	size_t vertex_size = encoder->vertex_size;
+	size_t vertex_block_size = getVertexBlockSize(vertex_size);
+
+	const unsigned char* vertex_data = static_cast<const unsigned char*>(vertices);
+
+	while (vertex_count > 0)
+	{
+		// only full blocks are flushed here; the last (possibly partial) block is flushed in meshopt_encodeVertexStreamEnd
+		if (encoder->block_vertices == vertex_block_size)
+			flushVertexStream(encoder);
+
+		size_t count = vertex_block_size - encoder->block_vertices;
+		count = count < vertex_count ? count : vertex_count;
+
+		memcpy(encoder->block + encoder->block_vertices * vertex_size, vertex_data, count * vertex_size);
+
+		encoder->block_vertices += count;
+		encoder->vertex_count += count;
+
+		vertex_data += count * vertex_size;
+		vertex_count -= count;
+	}
+}
+
+size_t meshopt_encodeVertexStreamEnd(struct meshopt_VertexStreamEncoder* encoder)
+{
+	using namespace meshopt;
+
+	if (encoder->block_vertices > 0)
+		flushVertexStream(encoder);
+
+	unsigned char tail[256 + 64 + kTailMinSizeV0];
+
+	unsigned char* end = encodeVertexTail(tail, tail + sizeof(tail), encoder->first_vertex, encoder->channels, encoder->vertex_size, encoder->version);
+	assert(end);
+
+	encoder->sink(encoder->context, tail, end - tail);
+	encoder->output_size += end - tail;
+
+	return encoder->output_size;
+}
+
 size_t meshopt_encodeVertexBufferBound(size_t vertex_count, size_t vertex_size)
 {
 	using namespace meshopt;
@@ -1772,6 +2258,19 @@ size_t meshopt_encodeVertexBufferBound(size_t vertex_count, size_t vertex_size)
 	return 1 + vertex_block_count * vertex_size * (vertex_block_control_size + vertex_block_header_size + vertex_block_data_size) + tail_size_pad;
 }
 
+size_t meshopt_encodeVertexSeekSize(size_t vertex_count, size_t vertex_size)
+{
+	using namespace meshopt;
+
+	assert(vertex_size > 0 && vertex_size <= 256);
+	assert(vertex_size % 4 == 0);
+
+	size_t vertex_block_size = getVertexBlockSize(vertex_size);
+	size_t vertex_block_count = (vertex_count + vertex_block_size - 1) / vertex_block_size;
+
+	return vertex_block_count * getVertexSeekEntrySize(vertex_size);
+}
+
 void meshopt_encodeVertexVersion(int version)
 {
 	assert(unsigned(version) <= unsigned(meshopt::kDecodeVertexVersion));
@@ -1796,28 +2295,23 @@ int meshopt_decodeVertexVersion(const unsigned char* buffer, size_t buffer_size)
 	return version;
 }
 
-int meshopt_decodeVertexBuffer(void* destination, size_t vertex_count, size_t vertex_size, const unsigned char* buffer, size_t buffer_size)
+namespace meshopt
 {
-	using namespace meshopt;
 
-	assert(vertex_size > 0 && vertex_size <= 256);
-	assert(vertex_size % 4 == 0);
+typedef void (*DecodeFilterFn)(void*, size_t, size_t);
 
-	const unsigned char* (*decode)(const unsigned char*, const unsigned char*, unsigned char*, size_t, size_t, unsigned char[256], const unsigned char*, int) = NULL;
+static void addReference(unsigned char* data, const unsigned char* reference, size_t size)
+{
+	for (size_t i = 0; i < size; ++i)
+		data[i] = (unsigned char)(data[i] + reference[i]);
+}
 
-#if defined(SIMD_SSE) && defined(SIMD_FALLBACK)
-	const unsigned int cpumask = (1 << 9) | (1 << 23); // SSSE3+POPCNT
-	decode = (cpuid & cpumask) == cpumask ? decodeVertexBlockSimd : decodeVertexBlock;
-#elif defined(SIMD_SSE) || defined(SIMD_AVX) || defined(SIMD_NEON) || defined(SIMD_WASM)
-	decode = decodeVertexBlockSimd;
-#else
-	decode = decodeVertexBlock;
-#endif
+static int decodeVertexBuffer(void* destination, size_t vertex_count, size_t vertex_size, const unsigned char* buffer, size_t buffer_size, const unsigned char* reference, DecodeFilterFn filter)
+{
+	assert(vertex_size > 0 && vertex_size <= 256);
+	assert(vertex_size % 4 == 0);
 
-#if defined(SIMD_SSE) || defined(SIMD_NEON) || defined(SIMD_WASM)
-	assert(gDecodeBytesGroupInitialized);
-	(void)gDecodeBytesGroupInitialized;
-#endif
+	DecodeVertexBlockFn decode = getDecodeVertexBlock();
 
 	unsigned char* vertex_data = static_cast<unsigned char*>(destination);
 
@@ -1862,6 +2356,13 @@ int meshopt_decodeVertexBuffer(void* destination, size_t vertex_count, size_t ve
 		if (!data)
 			return -2;
 
+		// apply reference and filter to the block while it's still in cache; on failure, the output is garbage either way
+		if (reference)
+			addReference(vertex_data + vertex_offset * vertex_size, reference + vertex_offset * vertex_size, block_size * vertex_size);
+
+		if (filter)
+			filter(vertex_data + vertex_offset * vertex_size, block_size, vertex_size);
+
 		vertex_offset += block_size;
 	}
 
@@ -1871,10 +2372,160 @@ int meshopt_decodeVertexBuffer(void* destination, size_t vertex_count, size_t ve
 	return 0;
 }
 
+} // namespace meshopt
+
+int meshopt_decodeVertexBuffer(void* destination, size_t vertex_count, size_t vertex_size, const unsigned char* buffer, size_t buffer_size)
+{
+	return meshopt::decodeVertexBuffer(destination, vertex_count, vertex_size, buffer, buffer_size, NULL, NULL);
+}
+
+int meshopt_decodeVertexBufferRef(void* destination, size_t vertex_count, size_t vertex_size, const unsigned char* buffer, size_t buffer_size, const void* reference)
+{
+	assert(reference);
+
+	return meshopt::decodeVertexBuffer(destination, vertex_count, vertex_size, buffer, buffer_size, static_cast<const unsigned char*>(reference), NULL);
+}
+
+int meshopt_decodeVertexBufferFiltered(void* destination, size_t vertex_count, size_t vertex_size, const unsigned char* buffer, size_t buffer_size, enum meshopt_DecodeFilter filter)
+{
+	using namespace meshopt;
+
+	DecodeFilterFn fn = NULL;
+
+	switch (filter)
+	{
+	case meshopt_DecodeFilterNone:
+		break;
+	case meshopt_DecodeFilterOct:
+		assert(vertex_size == 4 || vertex_size == 8);
+		fn = meshopt_decodeFilterOct;
+		break;
+	case meshopt_DecodeFilterQuat:
+		assert(vertex_size == 8);
+		fn = meshopt_decodeFilterQuat;
+		break;
+	case meshopt_DecodeFilterExp:
+		fn = meshopt_decodeFilterExp;
+		break;
+	case meshopt_DecodeFilterColor:
+		assert(vertex_size == 4 || vertex_size == 8);
+		fn = meshopt_decodeFilterColor;
+		break;
+	default:
+		assert(!"Unknown filter");
+	}
+
+	return decodeVertexBuffer(destination, vertex_count, vertex_size, buffer, buffer_size, NULL, fn);
+}
+
+int meshopt_decodeVertexBufferRange(void* destination, size_t first, size_t last, size_t vertex_count, size_t vertex_size, const unsigned char* buffer, size_t buffer_size, const unsigned char* seek, size_t seek_size)
+{
+	using namespace meshopt;
+
+	assert(vertex_size > 0 && vertex_size <= 256);
+	assert(vertex_size % 4 == 0);
+	assert(first <= last && last <= vertex_count);
+
+	DecodeVertexBlockFn decode = getDecodeVertexBlock();
+
+	unsigned char* vertex_data = static_cast<unsigned char*>(destination);
+
+	const unsigned char* data_end = buffer + buffer_size;
+
+	if (buffer_size < 1)
+		return -2;
+
+	unsigned char data_header = buffer[0];
+
+	if ((data_header & 0xf0) != kVertexHeader)
+		return -1;
+
+	int version = data_header & 0x0f;
+	if (version > kDecodeVertexVersion)
+		return -1;
+
+	size_t tail_size = vertex_size + (version == 0 ? 0 : vertex_size / 4);
+	size_t tail_size_min = version == 0 ? kTailMinSizeV0 : kTailMinSizeV1;
+	size_t tail_size_pad = tail_size < tail_size_min ? tail_size_min : tail_size;
+
+	if (buffer_size - 1 < tail_size_pad)
+		return -2;
+
+	if (seek_size < meshopt_encodeVertexSeekSize(vertex_count, vertex_size))
+		return -2;
+
+	const unsigned char* channels = version == 0 ? NULL : data_end - tail_size + vertex_size;
+
+	size_t vertex_block_size = getVertexBlockSize(vertex_size);
+	size_t seek_entry_size = getVertexSeekEntrySize(vertex_size);
+
+	// decode all blocks that overlap the range; partially covered blocks are decoded into a temporary buffer
+	unsigned char block[kVertexBlockSizeBytes];
+
+	for (size_t vertex_offset = first - first % vertex_block_size; vertex_offset < last; vertex_offset += vertex_block_size)
+	{
+		size_t block_size = (vertex_offset + vertex_block_size < vertex_count) ? vertex_block_size : vertex_count - vertex_offset;
+		assert(block_size * vertex_size <= sizeof(block));
+
+		const unsigned char* entry = seek + (vertex_offset / vertex_block_size) * seek_entry_size;
+		size_t offset = entry[0] | (entry[1] << 8) | (entry[2] << 16) | (size_t(entry[3]) << 24);
+
+		if (offset < 1 || offset > buffer_size - tail_size_pad)
+			return -2;
+
+		unsigned char last_vertex[256];
+		memcpy(last_vertex, entry + 4, vertex_size);
+
+		bool partial = vertex_offset < first || vertex_offset + block_size > last;
+		unsigned char* target = partial ? block : vertex_data + (vertex_offset - first) * vertex_size;
+
+		const unsigned char* data = decode(buffer + offset, data_end, target, block_size, vertex_size, last_vertex, channels, version);
+		if (!data)
+			return -2;
+
+		if (partial)
+		{
+			size_t copy_first = vertex_offset < first ? first : vertex_offset;
+			size_t copy_last = vertex_offset + block_size > last ? last : vertex_offset + block_size;
+
+			memcpy(vertex_data + (copy_first - first) * vertex_size, block + (copy_first - vertex_offset) * vertex_size, (copy_last - copy_first) * vertex_size);
+		}
+
+		// the last block must be followed by the tail, just like in meshopt_decodeVertexBuffer
+		if (vertex_offset + block_size == vertex_count && size_t(data_end - data) != tail_size_pad)
+			return -3;
+	}
+
+	return 0;
+}
+
+int meshopt_decodeVertexSimdLevel(int level)
+{
+	using namespace meshopt;
+
+	assert(level >= 0);
+
+	// scalar decoder is only compiled in when SIMD support needs to be detected at runtime
+#if defined(SIMD_FALLBACK) || (!defined(SIMD_SSE) && !defined(SIMD_NEON) && !defined(SIMD_AVX) && !defined(SIMD_WASM))
+	int min_level = 0;
+#elif defined(SIMD_AVX)
+	int min_level = 2;
+#else
+	int min_level = 1;
+#endif
+
+	gDecodeVertexSimdLevel = level < min_level ? min_level : (level > kDecodeVertexSimdLevel ? kDecodeVertexSimdLevel : level);
+
+	return gDecodeVertexSimdLevel;
+}
+
 #undef SIMD_NEON
 #undef SIMD_SSE
 #undef SIMD_AVX
 #undef SIMD_WASM
 #undef SIMD_FALLBACK
+#undef SIMD_DISPATCH
 #undef SIMD_TARGET
+#undef SIMD_TARGET_AVX512
+#undef SIMD_FLATTEN
 #undef SIMD_LATENCYOPT
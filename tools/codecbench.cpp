@@ -55,10 +55,11 @@ uint32_t murmur3(uint32_t h)
 	return h;
 }
 
-void benchCodecs(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices, double& bestvd, double& bestid, bool verbose)
+void benchCodecs(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices, double& bestvd, double& bestid, double& bestid16, bool verbose)
 {
 	std::vector<Vertex> vb(vertices.size());
 	std::vector<unsigned int> ib(indices.size());
+	std::vector<unsigned short> ib16(indices.size());
 
 	std::vector<unsigned char> vc(meshopt_encodeVertexBufferBound(vertices.size(), sizeof(Vertex)));
 	std::vector<unsigned char> ic(meshopt_encodeIndexBufferBound(indices.size(), vertices.size()));
@@ -95,13 +96,90 @@ void benchCodecs(const std::vector<Vertex>& vertices, const std::vector<unsigned
 
 		double t2 = timestamp();
 
+		// note: the mesh has more than 64K vertices so 16-bit output is truncated, but that does not affect decoding speed
+		int ri16 = meshopt_decodeIndexBuffer(&ib16[0], indices.size(), 2, &ic[0], ic.size());
+		assert(ri16 == 0);
+		(void)ri16;
+
+		double t3 = timestamp();
+
 		if (verbose)
-			printf("decode: vertex %.2f ms (%.2f GB/sec), index %.2f ms (%.2f GB/sec)\n",
+			printf("decode: vertex %.2f ms (%.2f GB/sec), index %.2f ms (%.2f GB/sec), index16 %.2f ms (%.2f GB/sec)\n",
 			    (t1 - t0) * 1000, double(vertices.size() * sizeof(Vertex)) / 1e9 / (t1 - t0),
-			    (t2 - t1) * 1000, double(indices.size() * 4) / 1e9 / (t2 - t1));
+			    (t2 - t1) * 1000, double(indices.size() * 4) / 1e9 / (t2 - t1),
+			    (t3 - t2) * 1000, double(indices.size() * 2) / 1e9 / (t3 - t2));
 
 		bestvd = std::max(bestvd, double(vertices.size() * sizeof(Vertex)) / 1e9 / (t1 - t0));
 		bestid = std::max(bestid, double(indices.size() * 4) / 1e9 / (t2 - t1));
+		bestid16 = std::max(bestid16, double(indices.size() * 2) / 1e9 / (t3 - t2));
+	}
+}
+
+void benchVertexLevels(const std::vector<Vertex>& vertices, double (&bestvl)[3], bool verbose)
+{
+	std::vector<Vertex> vb(vertices.size());
+	std::vector<unsigned char> vc(meshopt_encodeVertexBufferBound(vertices.size(), sizeof(Vertex)));
+
+	vc.resize(meshopt_encodeVertexBuffer(&vc[0], vc.size(), &vertices[0], vertices.size(), sizeof(Vertex)));
+
+	for (int level = 0; level < 3; ++level)
+	{
+		// levels that are not supported by the build or the CPU are clamped; we report them as missing
+		if (meshopt_decodeVertexSimdLevel(level) != level)
+			continue;
+
+		for (int attempt = 0; attempt < 50; ++attempt)
+		{
+			double t0 = timestamp();
+
+			int rv = meshopt_decodeVertexBuffer(&vb[0], vertices.size(), sizeof(Vertex), &vc[0], vc.size());
+			assert(rv == 0);
+			(void)rv;
+
+			double t1 = timestamp();
+
+			if (verbose)
+				printf("decode (level %d): vertex %.2f ms (%.2f GB/sec)\n", level, (t1 - t0) * 1000, double(vertices.size() * sizeof(Vertex)) / 1e9 / (t1 - t0));
+
+			bestvl[level] = std::max(bestvl[level], double(vertices.size() * sizeof(Vertex)) / 1e9 / (t1 - t0));
+		}
+	}
+
+	// restore default level
+	meshopt_decodeVertexSimdLevel(2);
+}
+
+void benchDecodeFiltered(const std::vector<Vertex>& vertices, double& bestsep, double& bestfused, bool verbose)
+{
+	// note: the filter is applied to the entire vertex; the output is meaningless but the work is the same as for real data
+	std::vector<Vertex> vb(vertices.size());
+	std::vector<unsigned char> vc(meshopt_encodeVertexBufferBound(vertices.size(), sizeof(Vertex)));
+
+	vc.resize(meshopt_encodeVertexBuffer(&vc[0], vc.size(), &vertices[0], vertices.size(), sizeof(Vertex)));
+
+	for (int attempt = 0; attempt < 50; ++attempt)
+	{
+		double t0 = timestamp();
+
+		int rv = meshopt_decodeVertexBuffer(&vb[0], vertices.size(), sizeof(Vertex), &vc[0], vc.size());
+		assert(rv == 0);
+		meshopt_decodeFilterExp(&vb[0], vertices.size(), sizeof(Vertex));
+
+		double t1 = timestamp();
+
+		int rf = meshopt_decodeVertexBufferFiltered(&vb[0], vertices.size(), sizeof(Vertex), &vc[0], vc.size(), meshopt_DecodeFilterExp);
+		assert(rf == 0);
+		(void)rv, (void)rf;
+
+		double t2 = timestamp();
+
+		if (verbose)
+			printf("decode+exp: separate %.2f ms (%.2f GB/sec), fused %.2f ms (%.2f GB/sec)\n",
+			    (t1 - t0) * 1000, double(vertices.size() * sizeof(Vertex)) / 1e9 / (t1 - t0),
+			    (t2 - t1) * 1000, double(vertices.size() * sizeof(Vertex)) / 1e9 / (t2 - t1));
+
+		bestsep = std::max(bestsep, double(vertices.size() * sizeof(Vertex)) / 1e9 / (t1 - t0));
+		bestfused = std::max(bestfused, double(vertices.size() * sizeof(Vertex)) / 1e9 / (t2 - t1));
 	}
 }
 
@@ -161,7 +239,7 @@ void benchFilters(size_t count, double& besto8, double& besto12, double& bestq12
 	}
 }
 
-void benchMeshlets(const std::vector<float>& positions, const std::vector<unsigned int>& indices, bool encoderefs, double& bestml, bool verbose)
+void benchMeshlets(const std::vector<float>& positions, const std::vector<unsigned int>& indices, bool encoderefs, double& bestml, double& bestmb, bool verbose)
 {
 	const size_t max_vertices = 64;
 	const size_t max_triangles = 96;
@@ -198,6 +276,10 @@ void benchMeshlets(const std::vector<float>& positions, const std::vector<unsign
 
 	std::vector<unsigned char> packed;
 
+	// batch decoding uses a separate stream without per-meshlet headers
+	std::vector<unsigned char> batch;
+	std::vector<unsigned int> batch_offsets(1, 0);
+
 	size_t totals = 0;
 
 	for (size_t i = 0; i < meshlets.size(); ++i)
@@ -215,6 +297,11 @@ void benchMeshlets(const std::vector<float>& positions, const std::vector<unsign
 		packed.push_back((unsigned char)((mbs >> 8) & 0xff));
 		packed.insert(packed.end(), cbuf.begin(), cbuf.begin() + mbs);
 
+		batch.insert(batch.end(), cbuf.begin(), cbuf.begin() + mbs);
+		batch_offsets.push_back(unsigned(batch.size()));
+
+		meshlets[i].vertex_count = unsigned(mvc);
+
 		totals += size_t(meshlet.triangle_count) * 3 + size_t(mvc) * 4;
 	}
 
@@ -249,6 +336,25 @@ void benchMeshlets(const std::vector<float>& positions, const std::vector<unsign
 
 		bestml = std::max(bestml, double(totals) / 1e9 / (t1 - t0));
 	}
+
+	std::vector<unsigned int> bv(meshlet_vertices.size() + 1);
+	std::vector<unsigned char> bt(meshlet_triangles.size() + 3);
+
+	for (int attempt = 0; attempt < 50; ++attempt)
+	{
+		double t0 = timestamp();
+
+		int rc = meshopt_decodeMeshletBatch(&bv[0], 4, &bt[0], 3, &meshlets[0], meshlets.size(), &batch[0], batch.size(), &batch_offsets[0]);
+		assert(rc == 0);
+		(void)rc;
+
+		double t1 = timestamp();
+
+		if (verbose)
+			printf("meshlet batch decode: %.2f ms (%.2f GB/sec)\n", (t1 - t0) * 1000, double(totals) / 1e9 / (t1 - t0));
+
+		bestmb = std::max(bestmb, double(totals) / 1e9 / (t1 - t0));
+	}
 }
 
 struct File
@@ -314,6 +420,24 @@ File readFile(const char* path)
 	}
 }
 
+void benchMeshletLevels(const std::vector<float>& positions, const std::vector<unsigned int>& indices, double (&bestml)[3])
+{
+	for (int level = 0; level < 3; ++level)
+	{
+		// levels that are not supported by the build or the CPU are clamped; we report them as missing
+		if (meshopt_decodeMeshletSimdLevel(level) != level)
+			continue;
+
+		double ml = 0, mb = 0;
+		benchMeshlets(positions, indices, /* encoderefs= */ true, ml, mb, /* verbose= */ false);
+
+		bestml[level] = mb;
+	}
+
+	// restore default level
+	meshopt_decodeMeshletSimdLevel(2);
+}
+
 int main(int argc, char** argv)
 {
 	bool verbose = false;
@@ -433,21 +557,51 @@ int main(int argc, char** argv)
 		}
 	}
 
-	printf("Codec:\tvtx\tidx\tmlet\tmletΔ\toct8\toct12\tquat12\tcol8\tcol12\texp\n");
+	printf("Codec:\tvtx\tidx\tidx16\tmlet\tmletΔ\tmletB\tmletBΔ\toct8\toct12\tquat12\tcol8\tcol12\texp\n");
 
 	for (int l = 0; l < (loop ? 100 : 1); ++l)
 	{
-		double bestvd = 0, bestid = 0;
-		benchCodecs(vertices, indices, bestvd, bestid, verbose);
+		double bestvd = 0, bestid = 0, bestid16 = 0;
+		benchCodecs(vertices, indices, bestvd, bestid, bestid16, verbose);
 
-		double bestml = 0, bestmt = 0;
-		benchMeshlets(positions, indices, /* encoderefs= */ true, bestml, verbose);
-		benchMeshlets(positions, indices, /* encoderefs= */ false, bestmt, verbose);
+		double bestml = 0, bestmt = 0, bestmb = 0, bestmtb = 0;
+		benchMeshlets(positions, indices, /* encoderefs= */ true, bestml, bestmb, verbose);
+		benchMeshlets(positions, indices, /* encoderefs= */ false, bestmt, bestmtb, verbose);
 
 		double besto8 = 0, besto12 = 0, bestq12 = 0, bestc8 = 0, bestc12 = 0, bestexp = 0;
 		benchFilters(8 * N * N, besto8, besto12, bestq12, bestc8, bestc12, bestexp, verbose);
 
-		printf("GB/s :\t%.2f\t%.2f\t%.2f\t%.2f\t%.2f\t%.2f\t%.2f\t%.2f\t%.2f\t%.2f\n",
-		    bestvd, bestid, bestml, bestmt, besto8, besto12, bestq12, bestc8, bestc12, bestexp);
+		printf("GB/s :\t%.2f\t%.2f\t%.2f\t%.2f\t%.2f\t%.2f\t%.2f\t%.2f\t%.2f\t%.2f\t%.2f\t%.2f\t%.2f\n",
+		    bestvd, bestid, bestid16, bestml, bestmt, bestmb, bestmtb, besto8, besto12, bestq12, bestc8, bestc12, bestexp);
+
+		double bestvl[3] = {};
+		benchVertexLevels(vertices, bestvl, verbose);
+
+		printf("vtx  :\tscalar\tsimd\tavx512\n");
+		printf("GB/s :");
+		for (int level = 0; level < 3; ++level)
+			if (bestvl[level] > 0)
+				printf("\t%.2f", bestvl[level]);
+			else
+				printf("\t-");
+		printf("\n");
+
+		double bestsep = 0, bestfused = 0;
+		benchDecodeFiltered(vertices, bestsep, bestfused, verbose);
+
+		printf("vtx+exp:\tseparate\tfused\n");
+		printf("GB/s :\t%.2f\t%.2f\n", bestsep, bestfused);
+
+		double bestmll[3] = {};
+		benchMeshletLevels(positions, indices, bestmll);
+
+		printf("mletB:\tscalar\tsimd\tavx2\n");
+		printf("GB/s :");
+		for (int level = 0; level < 3; ++level)
+			if (bestmll[level] > 0)
+				printf("\t%.2f", bestmll[level]);
+			else
+				printf("\t-");
+		printf("\n");
 	}
 }